@@ -0,0 +1,277 @@
+#ifndef BACKGROUND_SAVER_H
+#define BACKGROUND_SAVER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cstddef>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+// Kelas BackgroundSaver menulis snapshot dokumen ke disk di thread terpisah, sehingga
+// pengeditan bisa berlanjut selama penyimpanan berjalan. Snapshot berisi potongan
+// (piece) byte berurutan: sebagian menunjuk ke buffer teks milik snapshot, sebagian ke
+// memori lain yang tidak berubah (misalnya file yang dipetakan) dan dijaga tetap hidup
+// lewat keepAlive. Potongan ditulis dengan writev ke file sementara di direktori yang
+// sama, di-fsync, lalu di-rename menggantikan file tujuan, jadi file tujuan selalu
+// berisi versi lama yang utuh atau versi baru yang utuh.
+class BackgroundSaver {
+public:
+    // Satu potongan byte: dari text milik snapshot (external = false) atau dari
+    // externalData (external = true), mulai offset sepanjang length
+    struct Piece {
+        bool external;
+        size_t offset;
+        size_t length;
+    };
+
+    struct Snapshot {
+        std::string text;                  // Teks baris yang disalin saat snapshot diambil
+        const char* externalData = nullptr; // Awal memori eksternal (misalnya pemetaan file)
+        std::shared_ptr<const void> keepAlive; // Menjaga memori eksternal tetap valid
+        std::vector<Piece> pieces;
+        size_t bytes = 0;                  // Total byte yang akan ditulis
+
+        // Fungsi untuk menambahkan potongan, digabung dengan potongan sebelumnya jika
+        // keduanya bersambung di sumber yang sama
+        void add(bool external, size_t offset, size_t length) {
+            if (length == 0) return;
+            bytes += length;
+            if (!pieces.empty()) {
+                Piece& last = pieces.back();
+                if (last.external == external && last.offset + last.length == offset) {
+                    last.length += length;
+                    return;
+                }
+            }
+            pieces.push_back(Piece{ external, offset, length });
+        }
+
+        // Fungsi untuk menyalin teks ke snapshot lalu menambahkannya sebagai potongan
+        void addText(const char* data, size_t length) {
+            size_t offset = text.size();
+            text.append(data, length);
+            add(false, offset, length);
+        }
+    };
+
+    // Hasil satu kali penyimpanan
+    struct Result {
+        bool ok = false;
+        std::string path;
+        std::string error;
+        size_t bytes = 0;
+        size_t pieces = 0;
+        double milliseconds = 0.0;
+    };
+
+private:
+    std::thread worker;
+    std::function<Snapshot()> prepare; // Penyusun snapshot; dilepas di thread pemanggil setelah join
+    std::atomic<bool> finished;
+    bool running;   // Ada penyimpanan yang belum diambil hasilnya
+    Result result;  // Diisi worker; dibaca setelah finished bernilai true
+
+    static std::string systemError() {
+#ifdef _WIN32
+        return "kode galat " + std::to_string((unsigned long)GetLastError());
+#else
+        return std::strerror(errno);
+#endif
+    }
+
+    // Fungsi untuk menulis semua potongan ke file sementara lalu me-rename-nya
+    static void writeSnapshot(const std::string& path, const Snapshot& snapshot, Result& out) {
+        std::string temporary = path + ".tmp";
+        auto base = [&snapshot](const Piece& piece) {
+            return (piece.external ? snapshot.externalData : snapshot.text.data()) + piece.offset;
+        };
+#ifdef _WIN32
+        HANDLE file = CreateFileA(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            out.error = "gagal membuat \"" + temporary + "\": " + systemError();
+            return;
+        }
+        bool written = true;
+        for (const Piece& piece : snapshot.pieces) {
+            const char* data = base(piece);
+            size_t left = piece.length;
+            while (written && left > 0) {
+                DWORD chunk = (DWORD)std::min<size_t>(left, 1u << 30);
+                DWORD done = 0;
+                written = WriteFile(file, data, chunk, &done, nullptr) && done > 0;
+                data += done;
+                left -= done;
+            }
+        }
+        if (!written || !FlushFileBuffers(file)) {
+            out.error = "gagal menulis \"" + temporary + "\": " + systemError();
+            CloseHandle(file);
+            DeleteFileA(temporary.c_str());
+            return;
+        }
+        CloseHandle(file);
+        if (!MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            out.error = "gagal mengganti \"" + path + "\": " + systemError();
+            DeleteFileA(temporary.c_str());
+            return;
+        }
+#else
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            out.error = "gagal membuat \"" + temporary + "\": " + systemError();
+            return;
+        }
+        struct stat existing;
+        if (::stat(path.c_str(), &existing) == 0) fchmod(fd, existing.st_mode & 07777); // Izin file lama dipertahankan
+
+        // writev per kelompok IOV_MAX potongan; penulisan parsial dilanjutkan dari sisa
+        const size_t batchLimit = IOV_MAX;
+        std::vector<struct iovec> batch;
+        bool written = true;
+        for (size_t first = 0; written && first < snapshot.pieces.size(); first += batchLimit) {
+            size_t count = std::min(batchLimit, snapshot.pieces.size() - first);
+            batch.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                const Piece& piece = snapshot.pieces[first + i];
+                batch[i].iov_base = const_cast<char*>(base(piece));
+                batch[i].iov_len = piece.length;
+            }
+            struct iovec* current = batch.data();
+            int remaining = (int)count;
+            while (remaining > 0) {
+                ssize_t done = ::writev(fd, current, remaining);
+                if (done < 0 && errno == EINTR) continue;
+                if (done <= 0) {
+                    written = false;
+                    break;
+                }
+                while (remaining > 0 && (size_t)done >= current->iov_len) {
+                    done -= current->iov_len;
+                    current++;
+                    remaining--;
+                }
+                if (remaining > 0) {
+                    current->iov_base = static_cast<char*>(current->iov_base) + done;
+                    current->iov_len -= done;
+                }
+            }
+        }
+        if (!written || ::fsync(fd) != 0) {
+            out.error = "gagal menulis \"" + temporary + "\": " + systemError();
+            ::close(fd);
+            ::unlink(temporary.c_str());
+            return;
+        }
+        ::close(fd);
+        if (::rename(temporary.c_str(), path.c_str()) != 0) {
+            out.error = "gagal mengganti \"" + path + "\": " + systemError();
+            ::unlink(temporary.c_str());
+            return;
+        }
+
+        // fsync direktori agar rename juga tahan terhadap crash
+        size_t slash = path.find_last_of('/');
+        std::string directory = (slash == std::string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int directoryFd = ::open(directory.c_str(), O_RDONLY);
+        if (directoryFd >= 0) {
+            ::fsync(directoryFd);
+            ::close(directoryFd);
+        }
+#endif
+        out.ok = true;
+    }
+
+public:
+    BackgroundSaver() : finished(false), running(false) {}
+
+    // Destruktor menunggu penyimpanan yang masih berjalan agar file tidak setengah jadi
+    ~BackgroundSaver() {
+        if (worker.joinable()) worker.join();
+    }
+
+    BackgroundSaver(const BackgroundSaver&) = delete;
+    BackgroundSaver& operator=(const BackgroundSaver&) = delete;
+
+    // Fungsi untuk memeriksa apakah ada penyimpanan yang belum diambil hasilnya
+    bool busy() const {
+        return running;
+    }
+
+    // Fungsi untuk memulai penyimpanan di thread terpisah. Mengembalikan false jika
+    // penyimpanan sebelumnya belum selesai.
+    bool start(const std::string& path, Snapshot snapshot) {
+        return startPrepared(path, [data = std::move(snapshot)]() mutable { return std::move(data); });
+    }
+
+    // Fungsi untuk memulai penyimpanan yang snapshot-nya disusun oleh build() di
+    // thread penyimpan, misalnya dari versi dokumen yang tidak berubah, sehingga thread
+    // pemanggil tidak ikut menyalin teks. Objek yang ditangkap build baru dilepas oleh
+    // poll atau wait di thread pemanggil. Mengembalikan false jika penyimpanan
+    // sebelumnya belum selesai.
+    bool startPrepared(const std::string& path, std::function<Snapshot()> build) {
+        if (running) return false;
+        if (worker.joinable()) worker.join();
+        running = true;
+        finished.store(false, std::memory_order_relaxed);
+        result = Result();
+        prepare = std::move(build);
+        worker = std::thread([this, path]() {
+            auto begin = std::chrono::steady_clock::now();
+            Snapshot data = prepare();
+            Result out;
+            out.path = path;
+            out.bytes = data.bytes;
+            out.pieces = data.pieces.size();
+            writeSnapshot(path, data, out);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+            out.milliseconds = elapsed.count();
+            result = std::move(out);
+            finished.store(true, std::memory_order_release);
+        });
+        return true;
+    }
+
+    // Fungsi untuk mengambil hasil penyimpanan yang sudah selesai tanpa menunggu.
+    // Mengembalikan true sekali untuk setiap penyimpanan.
+    bool poll(Result& out) {
+        if (!running || !finished.load(std::memory_order_acquire)) return false;
+        worker.join();
+        prepare = nullptr;
+        running = false;
+        out = std::move(result);
+        return true;
+    }
+
+    // Fungsi untuk menunggu penyimpanan yang sedang berjalan lalu mengambil hasilnya.
+    // Mengembalikan false jika tidak ada penyimpanan.
+    bool wait(Result& out) {
+        if (!running) return false;
+        worker.join();
+        prepare = nullptr;
+        running = false;
+        out = std::move(result);
+        return true;
+    }
+};
+
+#endif
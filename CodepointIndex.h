@@ -0,0 +1,130 @@
+#ifndef CODEPOINT_INDEX_H
+#define CODEPOINT_INDEX_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// Kelas CodepointIndex memetakan kolom (nomor codepoint UTF-8) ke offset byte dan
+// sebaliknya di dalam satu baris panjang. Setiap STRIDE codepoint disimpan satu sampel
+// berisi offset byte dan kolomnya, sehingga pemetaan cukup mencari sampel terdekat
+// lalu berjalan paling banyak sekitar STRIDE codepoint, berapa pun panjang barisnya.
+//
+// Seperti TextStats, codepoint dihitung dari byte yang bukan byte lanjutan UTF-8
+// (10xxxxxx); byte lanjutan ikut karakter sebelumnya. Teks dibaca lewat fungsi at(i)
+// yang diberikan pemanggil, jadi baris di gap buffer tidak perlu disambung dulu.
+class CodepointIndex {
+public:
+    static constexpr size_t STRIDE = 64; // Codepoint di antara dua sampel saat disusun
+
+private:
+    struct Sample {
+        size_t byte;   // Offset byte
+        size_t column; // Jumlah codepoint yang dimulai sebelum byte
+    };
+
+    std::vector<Sample> samples; // Terurut menurut byte; sampel pertama selalu {0, 0}
+
+    // Fungsi untuk mendapatkan indeks sampel terakhir dengan offset byte <= byte
+    size_t sampleBefore(size_t byte) const {
+        auto it = std::upper_bound(samples.begin(), samples.end(), byte,
+                                   [](size_t value, const Sample& sample) { return value < sample.byte; });
+        return (size_t)(it - samples.begin()) - 1;
+    }
+
+    // Fungsi untuk menyusun ulang sampel di antara sampel ke-first dan sampel
+    // sesudahnya (atau akhir baris) dengan berjalan dari sampel ke-first
+    template <typename CharAt>
+    void resample(size_t first, size_t length, CharAt at) {
+        size_t end = (first + 1 < samples.size()) ? samples[first + 1].byte : length;
+        std::vector<Sample> added;
+        size_t column = samples[first].column;
+        size_t counted = 0;
+        for (size_t i = samples[first].byte; i < end; i++) {
+            if (!isContinuation(at(i))) {
+                if (counted > 0 && counted % STRIDE == 0) added.push_back(Sample{ i, column });
+                column++;
+                counted++;
+            }
+        }
+        samples.insert(samples.begin() + first + 1, added.begin(), added.end());
+    }
+
+public:
+    // Konstruktor; tanpa build() hanya ada sampel awal baris, jadi setiap pemetaan
+    // berjalan dari byte 0 (cukup untuk baris pendek)
+    CodepointIndex() : samples(1, Sample{ 0, 0 }) {}
+
+    static bool isContinuation(char c) {
+        return ((unsigned char)c & 0xC0) == 0x80;
+    }
+
+    // Fungsi untuk menyusun indeks dari baris sepanjang length byte dalam O(length)
+    template <typename CharAt>
+    void build(size_t length, CharAt at) {
+        samples.assign(1, Sample{ 0, 0 });
+        resample(0, length, at);
+    }
+
+    // Fungsi untuk membuang semua sampel kecuali sampel awal baris
+    void clear() {
+        std::vector<Sample>(1, Sample{ 0, 0 }).swap(samples);
+    }
+
+    size_t sampleCount() const {
+        return samples.size();
+    }
+
+    // Fungsi untuk mendapatkan kolom (dimulai dari 0) karakter yang memuat byte ke-byte;
+    // byte boleh sama dengan length (posisi sesudah karakter terakhir)
+    template <typename CharAt>
+    size_t columnOf(size_t byte, size_t length, CharAt at) const {
+        const Sample& sample = samples[sampleBefore(byte)];
+        size_t column = sample.column;
+        for (size_t i = sample.byte; i < byte; i++) {
+            column += !isContinuation(at(i));
+        }
+        // Byte lanjutan termasuk karakter sebelumnya
+        return (column > 0 && byte < length && isContinuation(at(byte))) ? column - 1 : column;
+    }
+
+    // Fungsi untuk mendapatkan offset byte awal karakter di kolom column; length jika
+    // baris lebih pendek dari column + 1 karakter
+    template <typename CharAt>
+    size_t byteOf(size_t column, size_t length, CharAt at) const {
+        auto it = std::upper_bound(samples.begin(), samples.end(), column,
+                                   [](size_t value, const Sample& sample) { return value < sample.column; });
+        const Sample& sample = *(it - 1);
+        size_t count = sample.column;
+        for (size_t i = sample.byte; i < length; i++) {
+            if (isContinuation(at(i))) continue;
+            if (count == column) return i;
+            count++;
+        }
+        return length;
+    }
+
+    // Fungsi untuk memperbarui indeks setelah removed byte di position diganti dengan
+    // inserted byte yang menambah columnDelta codepoint (bisa negatif); length dan at
+    // sudah menggambarkan teks baru. Sampel sesudah edit digeser, sampel di dalam
+    // potongan yang hilang dibuang, lalu bagian di sekitar edit disampel ulang. Biayanya
+    // O(jumlah sampel + STRIDE), jauh di bawah menyusun ulang seluruh baris.
+    template <typename CharAt>
+    void edited(size_t position, size_t removed, size_t inserted, long long columnDelta, size_t length, CharAt at) {
+        size_t first = sampleBefore(position);
+        size_t keep = first + 1;
+        size_t drop = keep;
+        while (drop < samples.size() && samples[drop].byte < position + removed) drop++;
+        samples.erase(samples.begin() + keep, samples.begin() + drop);
+        for (size_t i = keep; i < samples.size(); i++) {
+            samples[i].byte = samples[i].byte - removed + inserted;
+            samples[i].column = (size_t)((long long)samples[i].column + columnDelta);
+        }
+        // Potongan dari sampel first sampai sampel sesudahnya disusun ulang agar
+        // sampel tidak makin jarang oleh edit berulang di tempat yang sama
+        if (keep < samples.size()) samples.erase(samples.begin() + keep);
+        resample(first, length, at);
+    }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef GAP_BUFFER_H
+#define GAP_BUFFER_H
+
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+// Kelas GapBuffer menyimpan teks satu baris dengan celah (gap) kosong di posisi edit
+// terakhir. Menyisipkan atau menghapus karakter di tepi celah hanya menggeser batas
+// celah, jadi edit berulang di sekitar kursor bernilai O(1) amortized berapa pun
+// panjang barisnya. Memindahkan celah sejauh d karakter bernilai O(d), dan text()
+// memindahkan celah ke akhir agar teks bisa dibaca sebagai satu potongan bersambung.
+class GapBuffer {
+private:
+    static constexpr size_t MIN_GAP = 64; // Ukuran celah minimal saat teks dimuat atau buffer diperbesar
+
+    std::vector<char> buffer; // Teks sebelum celah, celah, lalu teks sesudah celah
+    size_t gapStart;          // Awal celah = panjang teks sebelum celah
+    size_t gapEnd;            // Akhir celah (eksklusif)
+
+    // Fungsi untuk memindahkan celah agar dimulai di position (indeks teks)
+    void moveGap(size_t position) {
+        if (position < gapStart) {
+            size_t count = gapStart - position;
+            memmove(buffer.data() + gapEnd - count, buffer.data() + position, count);
+            gapStart -= count;
+            gapEnd -= count;
+        }
+        else if (position > gapStart) {
+            size_t count = position - gapStart;
+            memmove(buffer.data() + gapStart, buffer.data() + gapEnd, count);
+            gapStart += count;
+            gapEnd += count;
+        }
+    }
+
+    // Fungsi untuk memperbesar buffer (kapasitas digandakan) ketika celah habis
+    void grow() {
+        size_t oldSize = buffer.size();
+        size_t tail = oldSize - gapEnd;
+        buffer.resize(std::max(oldSize * 2, oldSize + MIN_GAP));
+        memmove(buffer.data() + buffer.size() - tail, buffer.data() + gapEnd, tail);
+        gapEnd = buffer.size() - tail;
+    }
+
+public:
+    GapBuffer() : gapStart(0), gapEnd(0) {}
+
+    // Fungsi untuk memuat teks baru dengan celah di akhir (kapasitas lama dipakai ulang)
+    void load(std::string_view text) {
+        buffer.resize(text.size() + std::max(MIN_GAP, text.size() / 4));
+        if (!text.empty()) memcpy(buffer.data(), text.data(), text.size());
+        gapStart = text.size();
+        gapEnd = buffer.size();
+    }
+
+    // Fungsi untuk mendapatkan panjang teks (tanpa celah)
+    size_t length() const {
+        return buffer.size() - (gapEnd - gapStart);
+    }
+
+    // Fungsi untuk mendapatkan kapasitas buffer dalam byte
+    size_t capacity() const {
+        return buffer.capacity();
+    }
+
+    // Fungsi untuk membaca karakter ke-index
+    char at(size_t index) const {
+        return buffer[index < gapStart ? index : index + (gapEnd - gapStart)];
+    }
+
+    // Fungsi untuk mengganti karakter ke-index (celah tidak perlu dipindah)
+    void set(size_t index, char c) {
+        buffer[index < gapStart ? index : index + (gapEnd - gapStart)] = c;
+    }
+
+    // Fungsi untuk menyisipkan karakter c sehingga menjadi karakter ke-position
+    void insert(size_t position, char c) {
+        if (gapStart == gapEnd) grow();
+        moveGap(position);
+        buffer[gapStart++] = c;
+    }
+
+    // Fungsi untuk menghapus karakter ke-position
+    void erase(size_t position) {
+        moveGap(position);
+        gapEnd++;
+    }
+
+    // Fungsi untuk mendapatkan seluruh teks sebagai satu potongan bersambung. Celah
+    // dipindah ke akhir; hasilnya berlaku sampai buffer diubah lagi.
+    std::string_view text() {
+        moveGap(length());
+        return std::string_view(buffer.data(), gapStart);
+    }
+
+    // Fungsi untuk mengosongkan buffer dan melepas memorinya
+    void clear() {
+        std::vector<char>().swap(buffer);
+        gapStart = gapEnd = 0;
+    }
+};
+
+#endif
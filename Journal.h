@@ -0,0 +1,411 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <cerrno>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+// Kelas Journal adalah log catatan biner yang hanya ditambah di ujung, untuk memulihkan
+// sesi setelah crash. File jurnal diawali header yang mengikatnya ke satu versi file
+// dasar (ukuran dan waktu modifikasi); setiap catatan disimpan sebagai
+// [panjang u32][crc32 u32][isi]. Catatan yang terpotong atau rusak di ujung file
+// (misalnya karena crash di tengah penulisan) dibuang saat jurnal dibuka.
+//
+// Catatan dikumpulkan di buffer dan ditulis + di-fsync sekaligus (group commit):
+// ketika buffer melewati GROUP_BYTES, ketika GROUP_INTERVAL sudah lewat sejak fsync
+// terakhir, atau ketika pemanggil memanggil commit() (misalnya sebelum menunggu input).
+class Journal {
+public:
+    // Identitas file dasar: jurnal hanya diputar ulang di atas file yang sama persis
+    struct FileIdentity {
+        uint64_t size = 0;
+        int64_t modified = 0; // Waktu modifikasi (satuan bergantung OS, hanya dibandingkan)
+
+        bool operator==(const FileIdentity& other) const {
+            return size == other.size && modified == other.modified;
+        }
+    };
+
+    enum OpenStatus { CREATED, RECOVERED, REPLACED_STALE, FAILED };
+
+    // Fungsi untuk menambahkan bilangan tak bertanda dalam format varint (7 bit per byte)
+    static void putVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((char)((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back((char)value);
+    }
+
+    // Fungsi untuk menambahkan string dengan panjangnya
+    static void putString(std::string& out, std::string_view text) {
+        putVarint(out, text.size());
+        out.append(text.data(), text.size());
+    }
+
+    // Kelas Reader membaca isi catatan yang ditulis dengan putVarint/putString. Setelah
+    // pembacaan yang melewati batas, ok() bernilai false.
+    class Reader {
+    private:
+        std::string_view data;
+        size_t position;
+        bool valid;
+
+    public:
+        explicit Reader(std::string_view data) : data(data), position(0), valid(true) {}
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (position >= data.size()) break;
+                unsigned char byte = (unsigned char)data[position++];
+                value |= (uint64_t)(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return value;
+            }
+            valid = false;
+            return 0;
+        }
+
+        unsigned char byte() {
+            if (position >= data.size()) {
+                valid = false;
+                return 0;
+            }
+            return (unsigned char)data[position++];
+        }
+
+        std::string_view string() {
+            uint64_t length = varint();
+            if (!valid || length > data.size() - position) {
+                valid = false;
+                return std::string_view();
+            }
+            std::string_view result = data.substr(position, (size_t)length);
+            position += (size_t)length;
+            return result;
+        }
+
+        bool ok() const { return valid; }
+        bool atEnd() const { return position == data.size(); }
+    };
+
+private:
+    static const size_t GROUP_BYTES = 64 * 1024;                      // Buffer maksimum sebelum fsync
+    static constexpr std::chrono::milliseconds GROUP_INTERVAL{ 100 }; // Jeda maksimum sebelum fsync
+    static constexpr char MAGIC[8] = { 'T', 'E', 'J', 'U', 'R', 'N', 'A', 'L' };
+    static const uint32_t VERSION = 1;
+    static const size_t HEADER_SIZE = 8 + 4 + 8 + 8;
+    static const uint32_t MAX_RECORD = 1u << 30;
+
+    std::string path;
+    int fd;                  // Descriptor file jurnal (-1 = tertutup)
+    std::string buffer;      // Catatan yang belum ditulis
+    uint64_t fileBytes;      // Byte yang sudah ada di file
+    size_t recordCount;      // Catatan di jurnal (termasuk yang dipulihkan)
+    size_t commitCount;      // Jumlah fsync sejak dibuka
+    std::chrono::steady_clock::time_point lastCommit;
+
+    static uint32_t crc32(const char* data, size_t length) {
+        static uint32_t table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                table[i] = c;
+            }
+            ready = true;
+        }
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < length; i++) crc = table[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    static void putFixed(std::string& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) out.push_back((char)((value >> (8 * i)) & 0xFF));
+    }
+
+    static uint64_t getFixed(const char* data, int bytes) {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= (uint64_t)(unsigned char)data[i] << (8 * i);
+        return value;
+    }
+
+    static std::string header(const FileIdentity& base) {
+        std::string out(MAGIC, sizeof(MAGIC));
+        putFixed(out, VERSION, 4);
+        putFixed(out, base.size, 8);
+        putFixed(out, (uint64_t)base.modified, 8);
+        return out;
+    }
+
+    // Pembungkus kecil agar kode di bawah sama untuk POSIX dan Windows
+    static int openFile(const std::string& name, bool create) {
+#ifdef _WIN32
+        return _open(name.c_str(), _O_RDWR | _O_BINARY | (create ? _O_CREAT | _O_TRUNC : 0), _S_IREAD | _S_IWRITE);
+#else
+        return ::open(name.c_str(), O_RDWR | (create ? O_CREAT | O_TRUNC : 0), 0644);
+#endif
+    }
+
+    static bool writeAll(int handle, const char* data, size_t length) {
+        while (length > 0) {
+#ifdef _WIN32
+            int written = _write(handle, data, (unsigned int)std::min<size_t>(length, 1u << 30));
+#else
+            ssize_t written = ::write(handle, data, length);
+            if (written < 0 && errno == EINTR) continue;
+#endif
+            if (written <= 0) return false;
+            data += written;
+            length -= (size_t)written;
+        }
+        return true;
+    }
+
+    static bool syncFile(int handle) {
+#ifdef _WIN32
+        return _commit(handle) == 0;
+#elif defined(__APPLE__)
+        return ::fsync(handle) == 0;
+#else
+        return ::fdatasync(handle) == 0;
+#endif
+    }
+
+    static void closeFile(int handle) {
+#ifdef _WIN32
+        _close(handle);
+#else
+        ::close(handle);
+#endif
+    }
+
+    static bool truncateFile(int handle, uint64_t length) {
+#ifdef _WIN32
+        return _chsize_s(handle, (long long)length) == 0 && _lseeki64(handle, 0, SEEK_END) >= 0;
+#else
+        return ::ftruncate(handle, (off_t)length) == 0 && ::lseek(handle, 0, SEEK_END) >= 0;
+#endif
+    }
+
+    static bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return ::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    // Fungsi untuk membaca seluruh isi file kecil-menengah (jurnal) ke memori
+    static bool readFile(const std::string& name, std::string& content) {
+        FILE* file = fopen(name.c_str(), "rb");
+        if (file == nullptr) return false;
+        content.clear();
+        char chunk[1 << 16];
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0) content.append(chunk, got);
+        bool ok = !ferror(file);
+        fclose(file);
+        return ok;
+    }
+
+    // Fungsi untuk membuat file jurnal baru berisi header + tail lewat file sementara
+    bool create(const std::string& name, const FileIdentity& base, std::string_view tail) {
+        std::string temporary = name + ".tmp";
+        int handle = openFile(temporary, true);
+        if (handle < 0) return false;
+        std::string content = header(base);
+        content.append(tail.data(), tail.size());
+        if (!writeAll(handle, content.data(), content.size()) || !syncFile(handle)) {
+            closeFile(handle);
+            std::remove(temporary.c_str());
+            return false;
+        }
+        closeFile(handle);
+        if (!replaceFile(temporary, name)) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        handle = openFile(name, false);
+        if (handle < 0 || !truncateFile(handle, content.size())) {
+            if (handle >= 0) closeFile(handle);
+            return false;
+        }
+        fd = handle;
+        path = name;
+        fileBytes = content.size();
+        return true;
+    }
+
+public:
+    Journal() : fd(-1), fileBytes(0), recordCount(0), commitCount(0) {}
+
+    ~Journal() {
+        close(false);
+    }
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Fungsi untuk membaca identitas sebuah file; false jika file tidak bisa dibaca
+    static bool identify(const std::string& name, FileIdentity& identity) {
+#ifdef _WIN32
+        WIN32_FILE_ATTRIBUTE_DATA info;
+        if (!GetFileAttributesExA(name.c_str(), GetFileExInfoStandard, &info)) return false;
+        identity.size = ((uint64_t)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+        identity.modified = (int64_t)(((uint64_t)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime);
+#else
+        struct stat info;
+        if (::stat(name.c_str(), &info) != 0) return false;
+        identity.size = (uint64_t)info.st_size;
+#ifdef __APPLE__
+        identity.modified = (int64_t)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+        identity.modified = (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+#endif
+        return true;
+    }
+
+    // Fungsi untuk membuka jurnal name untuk file dasar base. Jika jurnal yang cocok
+    // sudah ada, replay(isiCatatan) dipanggil untuk setiap catatan utuh secara berurutan
+    // (berhenti jika replay mengembalikan false) dan catatan berikutnya ditambahkan di
+    // ujungnya. Jurnal milik versi file lain dipindahkan ke name + ".old".
+    template <typename Replay>
+    OpenStatus open(const std::string& name, const FileIdentity& base, Replay replay) {
+        close(false);
+        recordCount = 0;
+        commitCount = 0;
+        lastCommit = std::chrono::steady_clock::now();
+
+        std::string content;
+        if (!readFile(name, content)) return create(name, base, std::string_view()) ? CREATED : FAILED;
+
+        bool matches = content.size() >= HEADER_SIZE && memcmp(content.data(), MAGIC, sizeof(MAGIC)) == 0 &&
+                       getFixed(content.data() + 8, 4) == VERSION && getFixed(content.data() + 12, 8) == base.size &&
+                       (int64_t)getFixed(content.data() + 20, 8) == base.modified;
+        if (!matches) {
+            replaceFile(name, name + ".old");
+            return create(name, base, std::string_view()) ? REPLACED_STALE : FAILED;
+        }
+
+        // Memutar ulang catatan utuh; sisa yang rusak di ujung dibuang
+        size_t position = HEADER_SIZE;
+        while (content.size() - position >= 8) {
+            uint32_t length = (uint32_t)getFixed(content.data() + position, 4);
+            uint32_t checksum = (uint32_t)getFixed(content.data() + position + 4, 4);
+            if (length > MAX_RECORD || length > content.size() - position - 8) break;
+            const char* payload = content.data() + position + 8;
+            if (crc32(payload, length) != checksum) break;
+            if (!replay(std::string_view(payload, length))) break;
+            position += 8 + length;
+            recordCount++;
+        }
+
+        int handle = openFile(name, false);
+        if (handle < 0) return FAILED;
+        if (position < content.size() && !(truncateFile(handle, position) && syncFile(handle))) {
+            closeFile(handle);
+            return FAILED;
+        }
+        if (!truncateFile(handle, position)) {
+            closeFile(handle);
+            return FAILED;
+        }
+        fd = handle;
+        path = name;
+        fileBytes = position;
+        return RECOVERED;
+    }
+
+    bool isOpen() const { return fd >= 0; }
+    const std::string& filePath() const { return path; }
+    size_t records() const { return recordCount; }
+    size_t commits() const { return commitCount; }
+
+    // Fungsi untuk mendapatkan posisi logis ujung jurnal (termasuk catatan di buffer)
+    uint64_t position() const { return fileBytes + buffer.size(); }
+
+    // Fungsi untuk menambahkan satu catatan. fsync dilakukan per kelompok catatan.
+    void append(std::string_view payload) {
+        if (fd < 0) return;
+        putFixed(buffer, payload.size(), 4);
+        putFixed(buffer, crc32(payload.data(), payload.size()), 4);
+        buffer.append(payload.data(), payload.size());
+        recordCount++;
+        if (buffer.size() >= GROUP_BYTES || std::chrono::steady_clock::now() - lastCommit >= GROUP_INTERVAL) commit();
+    }
+
+    // Fungsi untuk menulis dan meng-fsync semua catatan di buffer. Mengembalikan false
+    // jika penulisan gagal (jurnal lalu ditutup agar tidak berisi celah).
+    bool commit() {
+        lastCommit = std::chrono::steady_clock::now();
+        if (fd < 0 || buffer.empty()) return true;
+        if (!writeAll(fd, buffer.data(), buffer.size()) || !syncFile(fd)) {
+            closeFile(fd);
+            fd = -1;
+            buffer.clear();
+            return false;
+        }
+        fileBytes += buffer.size();
+        buffer.clear();
+        commitCount++;
+        return true;
+    }
+
+    // Fungsi untuk memindahkan jurnal ke file dasar yang baru (setelah dokumen disimpan):
+    // jurnal baru name hanya berisi catatan sejak posisi from, dan jurnal lama dihapus
+    // jika namanya berbeda
+    bool rebase(const std::string& name, const FileIdentity& base, uint64_t from) {
+        if (!commit()) return false;
+        std::string tail;
+        if (fd >= 0) {
+            std::string content;
+            if (!readFile(path, content)) return false;
+            if (from < HEADER_SIZE) from = HEADER_SIZE;
+            if (from < content.size()) tail = content.substr((size_t)from);
+        }
+        std::string oldPath = path;
+        bool wasOpen = fd >= 0;
+        if (wasOpen) closeFile(fd);
+        fd = -1;
+        if (!create(name, base, tail)) return false;
+        if (wasOpen && oldPath != name) std::remove(oldPath.c_str());
+        return true;
+    }
+
+    // Fungsi untuk menutup jurnal; jika remove bernilai true file jurnal dihapus
+    // (sesi berakhir normal), jika tidak catatan di buffer di-fsync terlebih dahulu
+    void close(bool remove) {
+        if (fd < 0) return;
+        if (!remove) commit();
+        buffer.clear();
+        closeFile(fd);
+        fd = -1;
+        if (remove) std::remove(path.c_str());
+    }
+};
+
+#endif
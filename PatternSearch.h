@@ -0,0 +1,809 @@
+#ifndef PATTERN_SEARCH_H
+#define PATTERN_SEARCH_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <bitset>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+// Kelas PatternSearch mencari banyak kata sekaligus atau sebuah regex dalam satu kali
+// pindai per baris. Pola dikompilasi sekali menjadi automaton:
+//  - daftar kata   -> automaton Aho-Corasick (trie + failure link, tabel transisi penuh)
+//  - regex         -> NFA Thompson yang dijalankan sebagai DFA lazy (state DFA dibuat
+//                     saat pertama dibutuhkan lalu disimpan), sehingga waktu pindai linear
+//
+// Semantik kecocokan sama untuk keduanya: leftmost-longest dan tidak tumpang tindih di
+// dalam satu baris; kecocokan tidak pernah melewati batas baris. Regex yang didukung:
+// literal, '.', kelas [a-z] / [^...], \d \w \s \D \W \S, escape \. \\ \n \t dan
+// sejenisnya, grup (...), alternatif |, kuantor * + ? {m} {m,} {m,n}, serta jangkar
+// awal (^) dan akhir ($) baris. Untuk regex, posisi awal kecocokan ditandai dengan DFA
+// terbalik yang dijalankan mundur, lalu akhir terpanjangnya dicari dengan DFA maju.
+// Objek ini menyimpan cache DFA, jadi tidak boleh dipakai bersamaan dari beberapa thread.
+class PatternSearch {
+public:
+    static constexpr size_t npos = std::string::npos;
+
+private:
+    typedef std::bitset<256> ByteSet;
+
+    // ===== Aho-Corasick =====
+    struct AcState {
+        int fail;       // State untuk suffix terpanjang yang juga prefix sebuah kata
+        int depth;      // Panjang string yang diwakili state ini
+        int outLength;  // Panjang kata terpanjang yang berakhir di state ini (0 = tidak ada)
+    };
+
+    // ===== Regex =====
+    // Simpul AST hasil parsing regex
+    struct RegexNode {
+        enum Kind { SET, EMPTY, LINE_START, LINE_END, CONCAT, ALTERNATE, STAR, PLUS, QUEST };
+        Kind kind;
+        int set;                  // Indeks ByteSet (untuk SET)
+        std::vector<int> children;
+    };
+
+    // State NFA Thompson. AT_START/AT_END adalah asersi batas baris relatif terhadap arah
+    // pindai: pada NFA maju ^ menjadi AT_START, pada NFA terbalik ^ menjadi AT_END.
+    struct NfaState {
+        enum Kind { BYTES, SPLIT, EPSILON, AT_START, AT_END, MATCH };
+        Kind kind;
+        int set;  // Indeks ByteSet (untuk BYTES)
+        int out;  // State berikutnya
+        int out1; // Cabang kedua (untuk SPLIT)
+    };
+
+    // DFA lazy di atas sebuah NFA. Setiap state DFA adalah himpunan state NFA (BYTES,
+    // MATCH, dan asersi AT_END yang masih menunggu) yang terurut; transisi diisi saat
+    // pertama kali dilalui.
+    struct LazyDfa {
+        static constexpr int UNKNOWN = -1;
+        static constexpr size_t MAX_STATES = 4096; // Batas cache; jika terlampaui cache dikosongkan
+
+        std::vector<NfaState> nfa;
+        bool unanchored;                     // Start state ditambahkan lagi di setiap posisi
+        std::vector<std::vector<int>> sets;  // Himpunan state NFA untuk setiap state DFA
+        std::map<std::vector<int>, int> ids; // Himpunan -> id state DFA
+        std::vector<int> table;              // table[state * classCount + kelas] = state berikutnya
+        std::vector<char> matching;          // State memuat MATCH
+        std::vector<char> matchingAtEnd;     // State memuat MATCH jika posisi ini batas akhir baris
+        std::vector<int> startAtBoundary;    // Closure start di batas awal pindai (AT_START lolos)
+        std::vector<int> startInside;        // Closure start di tengah baris
+        int classCount;
+
+        LazyDfa() : unanchored(false), classCount(1) {}
+
+        // Closure epsilon; atStart/atEnd menyatakan apakah posisi saat ini batas awal/akhir
+        // pindai. AT_START yang tidak terpenuhi dibuang, AT_END yang belum terpenuhi disimpan
+        // karena masih bisa terpenuhi jika ternyata tidak ada byte lagi.
+        void closure(int state, std::vector<int>& result, std::vector<char>& seen, bool atStart, bool atEnd) const {
+            if (state < 0 || seen[state]) return;
+            seen[state] = 1;
+            const NfaState& s = nfa[state];
+            switch (s.kind) {
+                case NfaState::SPLIT:
+                    closure(s.out, result, seen, atStart, atEnd);
+                    closure(s.out1, result, seen, atStart, atEnd);
+                    break;
+                case NfaState::EPSILON:
+                    closure(s.out, result, seen, atStart, atEnd);
+                    break;
+                case NfaState::AT_START:
+                    if (atStart) closure(s.out, result, seen, atStart, atEnd);
+                    break;
+                case NfaState::AT_END:
+                    if (atEnd) closure(s.out, result, seen, atStart, atEnd);
+                    else result.push_back(state);
+                    break;
+                default:
+                    result.push_back(state);
+                    break;
+            }
+        }
+
+        std::vector<int> startSet(int start, bool atStart) const {
+            std::vector<int> result;
+            std::vector<char> seen(nfa.size(), 0);
+            closure(start, result, seen, atStart, false);
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        // Fungsi untuk memeriksa apakah sebuah himpunan state NFA memuat MATCH
+        bool containsMatch(const std::vector<int>& set) const {
+            for (int s : set) {
+                if (nfa[s].kind == NfaState::MATCH) return true;
+            }
+            return false;
+        }
+
+        void prepare(int start, bool isUnanchored, int classes) {
+            unanchored = isUnanchored;
+            classCount = classes;
+            startAtBoundary = startSet(start, true);
+            startInside = startSet(start, false);
+            reset();
+        }
+
+        void reset() {
+            sets.clear();
+            ids.clear();
+            table.clear();
+            matching.clear();
+            matchingAtEnd.clear();
+        }
+
+        int intern(const std::vector<int>& set) {
+            std::map<std::vector<int>, int>::iterator found = ids.find(set);
+            if (found != ids.end()) return found->second;
+            int id = (int)sets.size();
+            sets.push_back(set);
+            ids[set] = id;
+            table.resize(table.size() + classCount, UNKNOWN);
+
+            // Di batas akhir, asersi AT_END yang menunggu ikut dilalui
+            std::vector<int> atEnd;
+            std::vector<char> seen(nfa.size(), 0);
+            for (int s : set) closure(s, atEnd, seen, false, true);
+            matching.push_back(containsMatch(set));
+            matchingAtEnd.push_back(containsMatch(atEnd));
+            return id;
+        }
+
+        // Fungsi untuk mendapatkan state awal; atBoundary = pindai dimulai di batas baris
+        int start(bool atBoundary) {
+            return intern(atBoundary ? startAtBoundary : startInside);
+        }
+
+        bool isMatch(int state) const { return matching[state] != 0; }
+        bool isMatchAtEnd(int state) const { return matchingAtEnd[state] != 0; }
+        bool isDead(int state) const { return sets[state].empty() && !unanchored; }
+
+        // Fungsi untuk menghitung (atau mengambil dari cache) transisi state dengan sebuah byte
+        int next(int state, unsigned char byte, const std::vector<ByteSet>& byteSets, int byteClass) {
+            int cached = table[(size_t)state * classCount + byteClass];
+            if (cached != UNKNOWN) return cached;
+
+            std::vector<int> target;
+            std::vector<char> seen(nfa.size(), 0);
+            for (int s : sets[state]) {
+                const NfaState& n = nfa[s];
+                if (n.kind == NfaState::BYTES && byteSets[n.set][byte]) closure(n.out, target, seen, false, false);
+            }
+            if (unanchored) {
+                for (int s : startInside) {
+                    if (!seen[s]) {
+                        seen[s] = 1;
+                        target.push_back(s);
+                    }
+                }
+            }
+            std::sort(target.begin(), target.end());
+
+            if (sets.size() >= MAX_STATES) {
+                // Cache penuh: mulai lagi dari awal hanya dengan state saat ini
+                std::vector<int> current = sets[state];
+                reset();
+                state = intern(current);
+            }
+            int id = intern(target);
+            table[(size_t)state * classCount + byteClass] = id;
+            return id;
+        }
+    };
+
+    bool isRegex;
+    std::string patternText; // Teks pola seperti yang dimasukkan pengguna (untuk pesan)
+    unsigned char byteClass[256]; // Byte -> kelas ekuivalen (byte yang tidak dibedakan pola)
+    int classCount;
+
+    // Data Aho-Corasick
+    std::vector<AcState> acStates;
+    std::vector<int> acTable; // acTable[state * classCount + kelas]
+
+    // Data regex
+    std::vector<ByteSet> byteSets;
+    std::vector<RegexNode> ast;
+    mutable LazyDfa forward;  // Regex anchored, dijalankan maju dari posisi awal kecocokan
+    mutable LazyDfa backward; // Regex terbalik, dijalankan mundur untuk menandai posisi awal
+    mutable std::vector<char> canStart;
+
+    // Fungsi untuk membagi 256 byte menjadi kelas ekuivalen: dua byte sekelas jika
+    // keanggotaannya sama di semua himpunan byte yang dipakai pola
+    void buildByteClasses(const std::vector<ByteSet>& sets) {
+        std::map<std::vector<bool>, int> signatures;
+        for (int b = 0; b < 256; b++) {
+            std::vector<bool> signature(sets.size());
+            for (size_t i = 0; i < sets.size(); i++) signature[i] = sets[i][b];
+            std::map<std::vector<bool>, int>::iterator found = signatures.find(signature);
+            if (found == signatures.end()) {
+                int id = (int)signatures.size();
+                signatures[signature] = id;
+                byteClass[b] = (unsigned char)id;
+            }
+            else {
+                byteClass[b] = (unsigned char)found->second;
+            }
+        }
+        classCount = (int)signatures.size();
+    }
+
+    // ===== Parser regex (recursive descent) =====
+    struct Parser {
+        const std::string& text;
+        size_t pos;
+        std::vector<RegexNode>& nodes;
+        std::vector<ByteSet>& sets;
+        std::string error;
+
+        Parser(const std::string& text, std::vector<RegexNode>& nodes, std::vector<ByteSet>& sets)
+            : text(text), pos(0), nodes(nodes), sets(sets) {}
+
+        int add(RegexNode::Kind kind, int set = -1) {
+            RegexNode node;
+            node.kind = kind;
+            node.set = set;
+            nodes.push_back(node);
+            return (int)nodes.size() - 1;
+        }
+
+        int addSet(const ByteSet& set) {
+            sets.push_back(set);
+            return add(RegexNode::SET, (int)sets.size() - 1);
+        }
+
+        int addNode(RegexNode::Kind kind, const std::vector<int>& children) {
+            int id = add(kind);
+            nodes[id].children = children;
+            return id;
+        }
+
+        // Salinan dalam sebuah subtree (dipakai untuk mengembangkan kuantor {m,n})
+        int clone(int id) {
+            RegexNode copy = nodes[id];
+            for (int& child : copy.children) child = clone(child);
+            nodes.push_back(copy);
+            return (int)nodes.size() - 1;
+        }
+
+        bool fail(const std::string& message) {
+            if (error.empty()) error = message + " (posisi " + std::to_string(pos + 1) + ")";
+            return false;
+        }
+
+        bool atEnd() const { return pos >= text.size(); }
+
+        static ByteSet classFor(char letter) {
+            ByteSet set;
+            switch (letter) {
+                case 'd': case 'D':
+                    for (int b = '0'; b <= '9'; b++) set.set(b);
+                    break;
+                case 'w': case 'W':
+                    for (int b = 0; b < 256; b++) {
+                        if ((b >= '0' && b <= '9') || (b >= 'a' && b <= 'z') || (b >= 'A' && b <= 'Z') || b == '_') set.set(b);
+                    }
+                    break;
+                case 's': case 'S':
+                    set.set(' '); set.set('\t'); set.set('\r'); set.set('\n'); set.set('\f'); set.set('\v');
+                    break;
+            }
+            if (letter == 'D' || letter == 'W' || letter == 'S') set.flip();
+            return set;
+        }
+
+        static int firstByte(const ByteSet& set) {
+            for (int b = 0; b < 256; b++) {
+                if (set[b]) return b;
+            }
+            return -1;
+        }
+
+        static int escapedByte(char letter) {
+            switch (letter) {
+                case 'n': return '\n';
+                case 't': return '\t';
+                case 'r': return '\r';
+                case 'f': return '\f';
+                case 'v': return '\v';
+                case '0': return '\0';
+                default: return (unsigned char)letter;
+            }
+        }
+
+        // Escape setelah '\'; hasilnya himpunan byte
+        bool parseEscape(ByteSet& set) {
+            if (atEnd()) return fail("Escape '\\' tanpa karakter");
+            char letter = text[pos++];
+            if (strchr("dDwWsS", letter) != nullptr) {
+                set = classFor(letter);
+            }
+            else {
+                set.reset();
+                set.set(escapedByte(letter));
+            }
+            return true;
+        }
+
+        bool parseClass(int& result) {
+            // pos berada tepat setelah '['
+            bool negate = false;
+            if (!atEnd() && text[pos] == '^') {
+                negate = true;
+                pos++;
+            }
+            ByteSet set;
+            bool first = true;
+            while (true) {
+                if (atEnd()) return fail("Kelas karakter '[' tidak ditutup");
+                char c = text[pos];
+                if (c == ']' && !first) {
+                    pos++;
+                    break;
+                }
+                first = false;
+                ByteSet item;
+                int low;
+                if (c == '\\') {
+                    pos++;
+                    if (!parseEscape(item)) return false;
+                    if (item.count() != 1) {
+                        set |= item;
+                        continue;
+                    }
+                    low = firstByte(item);
+                }
+                else {
+                    low = (unsigned char)c;
+                    pos++;
+                }
+                // Rentang a-z (tanda '-' di akhir kelas dianggap literal)
+                if (pos + 1 < text.size() && text[pos] == '-' && text[pos + 1] != ']') {
+                    pos++;
+                    int high;
+                    if (text[pos] == '\\') {
+                        pos++;
+                        ByteSet upper;
+                        if (!parseEscape(upper)) return false;
+                        if (upper.count() != 1) return fail("Rentang kelas karakter tidak valid");
+                        high = firstByte(upper);
+                    }
+                    else {
+                        high = (unsigned char)text[pos++];
+                    }
+                    if (high < low) return fail("Rentang kelas karakter terbalik");
+                    for (int b = low; b <= high; b++) set.set(b);
+                }
+                else {
+                    set.set(low);
+                }
+            }
+            if (negate) set.flip();
+            result = addSet(set);
+            return true;
+        }
+
+        bool parseNumber(int& value) {
+            if (atEnd() || text[pos] < '0' || text[pos] > '9') return fail("Angka diharapkan dalam kuantor {}");
+            value = 0;
+            while (!atEnd() && text[pos] >= '0' && text[pos] <= '9') {
+                value = value * 10 + (text[pos++] - '0');
+                if (value > 1000) return fail("Kuantor {} terlalu besar");
+            }
+            return true;
+        }
+
+        bool parseAtom(int& result) {
+            char c = text[pos];
+            if (c == '(') {
+                pos++;
+                if (!parseAlternate(result)) return false;
+                if (atEnd() || text[pos] != ')') return fail("Kurung '(' tidak ditutup");
+                pos++;
+                return true;
+            }
+            if (c == '[') {
+                pos++;
+                return parseClass(result);
+            }
+            if (c == '.') {
+                pos++;
+                ByteSet any;
+                any.set();
+                any.reset('\n');
+                result = addSet(any);
+                return true;
+            }
+            if (c == '\\') {
+                pos++;
+                ByteSet set;
+                if (!parseEscape(set)) return false;
+                result = addSet(set);
+                return true;
+            }
+            if (c == '^' || c == '$') {
+                pos++;
+                result = add(c == '^' ? RegexNode::LINE_START : RegexNode::LINE_END);
+                return true;
+            }
+            if (c == '*' || c == '+' || c == '?' || c == '{') return fail("Kuantor tanpa ekspresi sebelumnya");
+            if (c == ')') return fail("Kurung ')' tanpa pasangan");
+            pos++;
+            ByteSet set;
+            set.set((unsigned char)c);
+            result = addSet(set);
+            return true;
+        }
+
+        bool parseRepeat(int& result) {
+            if (!parseAtom(result)) return false;
+            while (!atEnd()) {
+                char c = text[pos];
+                if (c == '*') result = addNode(RegexNode::STAR, std::vector<int>(1, result));
+                else if (c == '+') result = addNode(RegexNode::PLUS, std::vector<int>(1, result));
+                else if (c == '?') result = addNode(RegexNode::QUEST, std::vector<int>(1, result));
+                else if (c == '{') {
+                    pos++;
+                    int low = 0, high = 0;
+                    if (!parseNumber(low)) return false;
+                    high = low;
+                    if (!atEnd() && text[pos] == ',') {
+                        pos++;
+                        high = -1; // Tanpa batas atas
+                        if (!atEnd() && text[pos] != '}' && !parseNumber(high)) return false;
+                    }
+                    if (atEnd() || text[pos] != '}') return fail("Kuantor '{' tidak ditutup");
+                    if (high != -1 && high < low) return fail("Kuantor {m,n} dengan n < m");
+                    // x{m,n} = x...x (m kali) diikuti (x?) sebanyak n - m, atau x* jika tanpa batas
+                    std::vector<int> parts;
+                    for (int i = 0; i < low; i++) parts.push_back(i == 0 ? result : clone(result));
+                    if (high == -1) {
+                        parts.push_back(addNode(RegexNode::STAR, std::vector<int>(1, low == 0 ? result : clone(result))));
+                    }
+                    else {
+                        for (int i = low; i < high; i++) {
+                            parts.push_back(addNode(RegexNode::QUEST, std::vector<int>(1, i == 0 ? result : clone(result))));
+                        }
+                    }
+                    result = parts.empty() ? add(RegexNode::EMPTY) : addNode(RegexNode::CONCAT, parts);
+                }
+                else break;
+                pos++;
+            }
+            return true;
+        }
+
+        bool parseConcat(int& result) {
+            std::vector<int> parts;
+            while (!atEnd() && text[pos] != '|' && text[pos] != ')') {
+                int part;
+                if (!parseRepeat(part)) return false;
+                parts.push_back(part);
+            }
+            result = parts.empty() ? add(RegexNode::EMPTY) : (parts.size() == 1 ? parts[0] : addNode(RegexNode::CONCAT, parts));
+            return true;
+        }
+
+        bool parseAlternate(int& result) {
+            std::vector<int> branches;
+            int branch;
+            if (!parseConcat(branch)) return false;
+            branches.push_back(branch);
+            while (!atEnd() && text[pos] == '|') {
+                pos++;
+                if (!parseConcat(branch)) return false;
+                branches.push_back(branch);
+            }
+            result = (branches.size() == 1) ? branches[0] : addNode(RegexNode::ALTERNATE, branches);
+            return true;
+        }
+    };
+
+    // ===== Konstruksi NFA Thompson dari AST =====
+    // Fragmen NFA: state awal dan state EPSILON akhir yang out-nya belum disambungkan
+    struct Fragment {
+        int start;
+        int accept;
+    };
+
+    static int addState(std::vector<NfaState>& nfa, NfaState::Kind kind, int set = -1, int out = -1, int out1 = -1) {
+        NfaState state;
+        state.kind = kind;
+        state.set = set;
+        state.out = out;
+        state.out1 = out1;
+        nfa.push_back(state);
+        return (int)nfa.size() - 1;
+    }
+
+    // reversed = true membangun NFA untuk bahasa terbalik (urutan CONCAT dibalik)
+    Fragment buildNfa(std::vector<NfaState>& nfa, int node, bool reversed) const {
+        const RegexNode& n = ast[node];
+        switch (n.kind) {
+            case RegexNode::SET: {
+                int accept = addState(nfa, NfaState::EPSILON);
+                int start = addState(nfa, NfaState::BYTES, n.set, accept);
+                return Fragment{ start, accept };
+            }
+            case RegexNode::EMPTY: {
+                int state = addState(nfa, NfaState::EPSILON);
+                return Fragment{ state, state };
+            }
+            case RegexNode::LINE_START:
+            case RegexNode::LINE_END: {
+                bool atStart = (n.kind == RegexNode::LINE_START) != reversed;
+                int accept = addState(nfa, NfaState::EPSILON);
+                int start = addState(nfa, atStart ? NfaState::AT_START : NfaState::AT_END, -1, accept);
+                return Fragment{ start, accept };
+            }
+            case RegexNode::CONCAT: {
+                std::vector<int> order = n.children;
+                if (reversed) std::reverse(order.begin(), order.end());
+                Fragment result = buildNfa(nfa, order[0], reversed);
+                for (size_t i = 1; i < order.size(); i++) {
+                    Fragment part = buildNfa(nfa, order[i], reversed);
+                    nfa[result.accept].out = part.start;
+                    result.accept = part.accept;
+                }
+                return result;
+            }
+            case RegexNode::ALTERNATE: {
+                int accept = addState(nfa, NfaState::EPSILON);
+                int start = -1;
+                for (size_t i = n.children.size(); i-- > 0; ) {
+                    Fragment branch = buildNfa(nfa, n.children[i], reversed);
+                    nfa[branch.accept].out = accept;
+                    start = (start == -1) ? branch.start : addState(nfa, NfaState::SPLIT, -1, branch.start, start);
+                }
+                return Fragment{ start, accept };
+            }
+            case RegexNode::STAR: {
+                Fragment body = buildNfa(nfa, n.children[0], reversed);
+                int accept = addState(nfa, NfaState::EPSILON);
+                int split = addState(nfa, NfaState::SPLIT, -1, body.start, accept);
+                nfa[body.accept].out = split;
+                return Fragment{ split, accept };
+            }
+            case RegexNode::PLUS: {
+                Fragment body = buildNfa(nfa, n.children[0], reversed);
+                int accept = addState(nfa, NfaState::EPSILON);
+                int split = addState(nfa, NfaState::SPLIT, -1, body.start, accept);
+                nfa[body.accept].out = split;
+                return Fragment{ body.start, accept };
+            }
+            default: { // QUEST
+                Fragment body = buildNfa(nfa, n.children[0], reversed);
+                int accept = addState(nfa, NfaState::EPSILON);
+                int split = addState(nfa, NfaState::SPLIT, -1, body.start, accept);
+                nfa[body.accept].out = accept;
+                return Fragment{ split, accept };
+            }
+        }
+    }
+
+    void prepareDfa(LazyDfa& dfa, int root, bool reversed, bool unanchored) {
+        dfa.nfa.clear();
+        Fragment fragment = buildNfa(dfa.nfa, root, reversed);
+        nfaMatch(dfa.nfa, fragment);
+        dfa.prepare(fragment.start, unanchored, classCount);
+    }
+
+    static void nfaMatch(std::vector<NfaState>& nfa, const Fragment& fragment) {
+        nfa[fragment.accept].out = addState(nfa, NfaState::MATCH);
+    }
+
+    // ===== Pencarian per baris =====
+    template <typename Visitor>
+    void scanLiterals(const char* line, size_t length, size_t from, Visitor visit) const {
+        size_t pos = from;
+        while (pos < length) {
+            int state = 0;
+            size_t bestStart = npos, bestEnd = 0;
+            for (size_t i = pos; i < length; i++) {
+                state = acTable[(size_t)state * classCount + byteClass[(unsigned char)line[i]]];
+                const AcState& s = acStates[state];
+                // Tidak ada kecocokan berikutnya yang bisa dimulai di atau sebelum bestStart
+                if (bestStart != npos && i + 1 - s.depth > bestStart) break;
+                if (s.outLength > 0) {
+                    size_t start = i + 1 - s.outLength;
+                    if (bestStart == npos || start <= bestStart) {
+                        bestStart = start;
+                        bestEnd = i + 1;
+                    }
+                }
+            }
+            if (bestStart == npos) return;
+            if (!visit(bestStart, bestEnd - bestStart)) return;
+            pos = bestEnd;
+        }
+    }
+
+    template <typename Visitor>
+    void scanRegex(const char* line, size_t length, size_t from, Visitor visit) const {
+        // Pindai mundur dari akhir baris: canStart[p] = ada kecocokan yang dimulai di p
+        canStart.assign(length + 1, 0);
+        int state = backward.start(true);
+        for (size_t p = length; p-- > from; ) {
+            unsigned char byte = (unsigned char)line[p];
+            state = backward.next(state, byte, byteSets, byteClass[byte]);
+            canStart[p] = (p == 0) ? backward.isMatchAtEnd(state) : backward.isMatch(state);
+        }
+
+        size_t pos = from;
+        while (pos < length) {
+            size_t start = pos;
+            while (start < length && !canStart[start]) start++;
+            if (start >= length) return;
+
+            // Pindai maju dari start untuk mencari akhir kecocokan terpanjang
+            size_t end = start;
+            int s = forward.start(start == 0);
+            for (size_t i = start; i < length; i++) {
+                unsigned char byte = (unsigned char)line[i];
+                s = forward.next(s, byte, byteSets, byteClass[byte]);
+                if ((i + 1 == length) ? forward.isMatchAtEnd(s) : forward.isMatch(s)) end = i + 1;
+                if (forward.isDead(s)) break;
+            }
+            if (end == start) { // Tidak terjadi: canStart menjamin ada kecocokan tidak kosong
+                pos = start + 1;
+                continue;
+            }
+            if (!visit(start, end - start)) return;
+            pos = end;
+        }
+    }
+
+public:
+    // Konstruktor untuk pola kosong (tidak cocok dengan apa pun sebelum dikompilasi)
+    PatternSearch() : isRegex(false), classCount(1) {
+        memset(byteClass, 0, sizeof(byteClass));
+        acStates.push_back(AcState{ 0, 0, 0 });
+        acTable.assign(1, 0);
+    }
+
+    // Fungsi untuk mengompilasi daftar kata menjadi automaton Aho-Corasick. Kata kosong
+    // diabaikan; mengembalikan false jika tidak ada kata sama sekali.
+    static bool compileLiterals(const std::vector<std::string>& words, PatternSearch& result, std::string& error) {
+        PatternSearch search;
+        search.isRegex = false;
+
+        // Kelas byte: setiap byte yang muncul di kata mendapat kelas sendiri, semua byte
+        // lain berbagi kelas 0
+        search.classCount = 1;
+        for (const std::string& word : words) {
+            for (unsigned char c : word) {
+                if (search.byteClass[c] == 0) search.byteClass[c] = (unsigned char)search.classCount++;
+            }
+        }
+
+        // Trie
+        std::vector<int> trie(search.classCount, -1); // Transisi trie (-1 = belum ada); state 0 = akar
+        int wordCount = 0;
+        for (const std::string& word : words) {
+            if (word.empty()) continue;
+            if (wordCount > 0) search.patternText += ' ';
+            search.patternText += word;
+            wordCount++;
+            int state = 0;
+            for (unsigned char c : word) {
+                int& next = trie[(size_t)state * search.classCount + search.byteClass[c]];
+                if (next == -1) {
+                    next = (int)search.acStates.size();
+                    search.acStates.push_back(AcState{ 0, search.acStates[state].depth + 1, 0 });
+                    trie.resize(trie.size() + search.classCount, -1);
+                }
+                state = trie[(size_t)state * search.classCount + search.byteClass[c]];
+            }
+            search.acStates[state].outLength = (int)word.size();
+        }
+        if (wordCount == 0) {
+            error = "Daftar kata tidak boleh kosong";
+            return false;
+        }
+
+        // BFS untuk failure link dan tabel transisi penuh (DFA Aho-Corasick)
+        search.acTable.assign(trie.size(), 0);
+        std::vector<int> queue;
+        for (int c = 0; c < search.classCount; c++) {
+            int next = trie[c];
+            if (next != -1) {
+                search.acTable[c] = next;
+                search.acStates[next].fail = 0;
+                queue.push_back(next);
+            }
+        }
+        for (size_t head = 0; head < queue.size(); head++) {
+            int state = queue[head];
+            AcState& s = search.acStates[state];
+            if (s.outLength == 0) s.outLength = search.acStates[s.fail].outLength;
+            for (int c = 0; c < search.classCount; c++) {
+                int next = trie[(size_t)state * search.classCount + c];
+                int viaFail = search.acTable[(size_t)s.fail * search.classCount + c];
+                if (next != -1) {
+                    search.acStates[next].fail = viaFail;
+                    search.acTable[(size_t)state * search.classCount + c] = next;
+                    queue.push_back(next);
+                }
+                else {
+                    search.acTable[(size_t)state * search.classCount + c] = viaFail;
+                }
+            }
+        }
+
+        result = search;
+        return true;
+    }
+
+    // Fungsi untuk mengompilasi regex. Jika gagal, error berisi alasannya.
+    static bool compileRegex(const std::string& pattern, PatternSearch& result, std::string& error) {
+        PatternSearch search;
+        search.isRegex = true;
+        search.patternText = pattern;
+
+        Parser parser(pattern, search.ast, search.byteSets);
+        int root;
+        if (!parser.parseAlternate(root)) {
+            error = parser.error;
+            return false;
+        }
+        if (!parser.atEnd()) {
+            parser.fail("Kurung ')' tanpa pasangan");
+            error = parser.error;
+            return false;
+        }
+
+        search.buildByteClasses(search.byteSets);
+        search.prepareDfa(search.forward, root, false, false);
+        search.prepareDfa(search.backward, root, true, true);
+        if (search.forward.isMatchAtEnd(search.forward.start(true))) {
+            error = "Pola tidak boleh cocok dengan teks kosong";
+            return false;
+        }
+        result = search;
+        return true;
+    }
+
+    bool regex() const { return isRegex; }
+    const std::string& pattern() const { return patternText; }
+
+    // Fungsi untuk mencari kecocokan pertama di text mulai dari offset from. Mengembalikan
+    // posisi awal (npos jika tidak ada) dan mengisi length dengan panjang kecocokan.
+    size_t match(std::string_view text, size_t from, size_t& length) const {
+        size_t found = npos;
+        auto first = [&](size_t start, size_t matchLength) {
+            found = start;
+            length = matchLength;
+            return false; // Cukup kecocokan pertama
+        };
+        if (isRegex) scanRegex(text.data(), text.size(), from, first);
+        else scanLiterals(text.data(), text.size(), from, first);
+        return found;
+    }
+
+    // Fungsi untuk memindai potongan teks berisi banyak baris; visit(baris, kolom, panjang)
+    // dipanggil untuk setiap kecocokan, dengan baris relatif terhadap awal potongan.
+    // '\r' sebelum '\n' tidak dianggap bagian baris.
+    template <typename Visitor>
+    void scanLines(const char* chunk, size_t length, Visitor visit) const {
+        size_t line = 0;
+        size_t begin = 0;
+        while (begin < length) {
+            const char* newline = static_cast<const char*>(memchr(chunk + begin, '\n', length - begin));
+            size_t end = (newline != nullptr) ? (size_t)(newline - chunk) : length;
+            size_t textEnd = (end > begin && chunk[end - 1] == '\r') ? end - 1 : end;
+            auto report = [&](size_t start, size_t matchLength) {
+                visit(line, start, matchLength);
+                return true;
+            };
+            if (isRegex) scanRegex(chunk + begin, textEnd - begin, 0, report);
+            else scanLiterals(chunk + begin, textEnd - begin, 0, report);
+            line++;
+            begin = end + 1;
+        }
+    }
+};
+
+#endif
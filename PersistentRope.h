@@ -0,0 +1,372 @@
+#ifndef PERSISTENT_ROPE_H
+#define PERSISTENT_ROPE_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Kelas PersistentRope menyimpan daftar baris sebagai treap implisit copy-on-write.
+// Snapshot cukup menyalin pointer akar (O(1)) dan sejak itu tidak pernah berubah:
+// edit berikutnya menyalin node yang masih dipakai bersama snapshot (hanya jalur dari
+// akar ke baris yang diedit, O(log n)) dan mengubah langsung node yang hanya dimiliki
+// versi terbaru. Jadi setelah sebuah snapshot setiap node disalin paling banyak sekali,
+// dan edit beruntun di daerah yang sama kembali secepat treap biasa.
+//
+// Thread lain boleh membaca snapshot tanpa kunci apa pun. Node dengan use_count() == 1
+// tidak mungkin terjangkau dari snapshot mana pun (induknya sendiri tidak dibagi), jadi
+// mengubahnya di tempat aman; pembaca hanya menyentuh penghitung referensi shared_ptr
+// yang sudah atomik saat snapshot-nya dilepas.
+//
+// Seperti rope milik editor, sebuah node bisa mewakili satu baris dengan teks sendiri
+// atau run berisi beberapa baris berurutan dari Source (misalnya file yang dipetakan).
+// Source harus menyediakan lineStart(baris) dan lineAt(offset, &offsetBerikutnya).
+template <typename Source>
+class PersistentRope {
+public:
+    struct Node {
+        std::shared_ptr<Node> left;
+        std::shared_ptr<Node> right;
+        unsigned int priority = 0;
+        size_t size = 0;                         // Jumlah baris dalam subtree
+        size_t runCount = 0;                     // 0 = baris dengan teks sendiri
+        size_t sourceLine = 0;                   // Baris pertama run di Source
+        std::shared_ptr<const std::string> text; // Teks baris (dipakai bersama oleh salinan node)
+
+        size_t weight() const { return runCount > 0 ? runCount : 1; }
+    };
+    using NodePtr = std::shared_ptr<Node>;
+
+    // Kelas Snapshot adalah satu versi dokumen yang tidak berubah. Menyalin snapshot
+    // hanya menyalin dua shared_ptr; teks yang dibaca dari snapshot tetap valid
+    // selama snapshot itu masih ada.
+    class Snapshot {
+    private:
+        std::shared_ptr<const Node> root;
+        std::shared_ptr<const Source> source;
+        uint64_t number;
+
+        template <typename Visitor>
+        static void visit(const Node* node, const Source* source, size_t& line, Visitor& visitor) {
+            while (node != nullptr) {
+                visit(node->left.get(), source, line, visitor);
+                if (node->runCount == 0) {
+                    visitor(line++, std::string_view(*node->text));
+                }
+                else {
+                    size_t offset = source->lineStart(node->sourceLine);
+                    for (size_t i = 0; i < node->runCount; i++) visitor(line++, source->lineAt(offset, &offset));
+                }
+                node = node->right.get(); // Subtree kanan ditelusuri tanpa rekursi
+            }
+        }
+
+        template <typename Visitor>
+        static void visitNodes(const Node* node, Visitor& visitor) {
+            while (node != nullptr) {
+                visitNodes(node->left.get(), visitor);
+                visitor(*node);
+                node = node->right.get();
+            }
+        }
+
+    public:
+        Snapshot() : number(0) {}
+        Snapshot(std::shared_ptr<const Node> root, std::shared_ptr<const Source> source, uint64_t number)
+            : root(std::move(root)), source(std::move(source)), number(number) {}
+
+        size_t lineCount() const { return root ? root->size : 0; }
+        uint64_t version() const { return number; }
+        const std::shared_ptr<const Source>& sourceFile() const { return source; }
+
+        // Fungsi untuk mendapatkan teks baris ke-position dalam O(log n)
+        std::string_view line(size_t position) const {
+            const Node* node = root.get();
+            while (node != nullptr) {
+                size_t leftSize = node->left ? node->left->size : 0;
+                if (position < leftSize) {
+                    node = node->left.get();
+                    continue;
+                }
+                position -= leftSize;
+                if (position < node->weight()) {
+                    if (node->runCount == 0) return *node->text;
+                    return source->lineAt(source->lineStart(node->sourceLine + position));
+                }
+                position -= node->weight();
+                node = node->right.get();
+            }
+            return std::string_view();
+        }
+
+        // Fungsi untuk menelusuri semua baris secara berurutan: visit(nomorBaris, teks)
+        template <typename Visitor>
+        void forEachLine(Visitor visitor) const {
+            size_t line = 0;
+            visit(root.get(), source.get(), line, visitor);
+        }
+
+        // Fungsi untuk menelusuri node secara berurutan tanpa membaca isi run:
+        // visit(node), misalnya untuk menyalin run sebagai rentang byte utuh
+        template <typename Visitor>
+        void forEachNode(Visitor visitor) const {
+            visitNodes(root.get(), visitor);
+        }
+    };
+
+private:
+    NodePtr root;
+    std::shared_ptr<const Source> source;
+    uint64_t number;    // Nomor versi, bertambah setiap kali dokumen berubah
+    unsigned int seed;  // State generator prioritas acak (xorshift32)
+
+    unsigned int nextPriority() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    static size_t sizeOf(const NodePtr& node) {
+        return node ? node->size : 0;
+    }
+
+    static void update(Node* node) {
+        node->size = node->weight() + sizeOf(node->left) + sizeOf(node->right);
+    }
+
+    // Fungsi untuk mendapatkan node di slot yang boleh diubah: node yang masih dipakai
+    // bersama versi lain diganti salinannya terlebih dahulu. Fence acquire memastikan
+    // pembacaan oleh thread yang baru saja melepas snapshot sudah selesai.
+    static Node* writable(NodePtr& slot) {
+        if (slot.use_count() == 1) std::atomic_thread_fence(std::memory_order_acquire);
+        else slot = std::make_shared<Node>(*slot);
+        return slot.get();
+    }
+
+    // Fungsi untuk membuat potongan run dari node (baris [first, first + count))
+    static NodePtr piece(const Node& node, size_t first, size_t count, NodePtr right) {
+        NodePtr result = std::make_shared<Node>();
+        result->priority = node.priority;
+        result->sourceLine = node.sourceLine + first;
+        result->runCount = count;
+        result->right = std::move(right);
+        update(result.get());
+        return result;
+    }
+
+    static NodePtr leaf(std::shared_ptr<const std::string> text, unsigned int priority) {
+        NodePtr node = std::make_shared<Node>();
+        node->priority = priority;
+        node->size = 1;
+        node->text = std::move(text);
+        return node;
+    }
+
+    // Fungsi untuk memecah treap: k baris pertama ke a, sisanya ke b. Run yang
+    // terpotong dibagi dua dengan prioritas yang sama, jadi sifat heap tetap terjaga.
+    static void split(NodePtr t, size_t k, NodePtr& a, NodePtr& b) {
+        if (!t) {
+            a = b = nullptr;
+            return;
+        }
+        Node* node = writable(t);
+        size_t leftSize = sizeOf(node->left);
+        if (k <= leftSize) {
+            split(std::move(node->left), k, a, node->left);
+            update(node);
+            b = std::move(t);
+        }
+        else if (k >= leftSize + node->weight()) {
+            split(std::move(node->right), k - leftSize - node->weight(), node->right, b);
+            update(node);
+            a = std::move(t);
+        }
+        else {
+            size_t cut = k - leftSize;
+            b = piece(*node, cut, node->runCount - cut, std::move(node->right));
+            node->runCount = cut;
+            update(node);
+            a = std::move(t);
+        }
+    }
+
+    // Fungsi untuk menggabungkan dua treap (semua baris a berada sebelum baris b)
+    static NodePtr merge(NodePtr a, NodePtr b) {
+        if (!a) return b;
+        if (!b) return a;
+        if (a->priority > b->priority) {
+            Node* node = writable(a);
+            node->right = merge(std::move(node->right), std::move(b));
+            update(node);
+            return a;
+        }
+        Node* node = writable(b);
+        node->left = merge(std::move(a), std::move(node->left));
+        update(node);
+        return b;
+    }
+
+    // Fungsi untuk menyisipkan node baru (tanpa anak) sebelum baris ke-k subtree slot
+    static void insertAt(NodePtr& slot, size_t k, NodePtr node) {
+        if (!slot) {
+            slot = std::move(node);
+            return;
+        }
+        if (node->priority > slot->priority) {
+            split(std::move(slot), k, node->left, node->right);
+            update(node.get());
+            slot = std::move(node);
+            return;
+        }
+        Node* t = writable(slot);
+        size_t leftSize = sizeOf(t->left);
+        if (k <= leftSize) insertAt(t->left, k, std::move(node));
+        else if (k >= leftSize + t->weight()) insertAt(t->right, k - leftSize - t->weight(), std::move(node));
+        else {
+            // Di tengah run: bagian setelah node baru menjadi potongan run tersendiri
+            size_t cut = k - leftSize;
+            NodePtr after = piece(*t, cut, t->runCount - cut, std::move(t->right));
+            t->runCount = cut;
+            t->right = merge(std::move(node), std::move(after));
+        }
+        update(t);
+    }
+
+    // Fungsi untuk mengganti teks baris ke-k subtree slot (text = nullptr menghapus
+    // baris itu). Baris di dalam run memecah run tersebut; baris pengganti memakai
+    // prioritas run agar sifat heap tetap terjaga.
+    static void replaceAt(NodePtr& slot, size_t k, std::shared_ptr<const std::string> text) {
+        Node* t = writable(slot);
+        size_t leftSize = sizeOf(t->left);
+        if (k < leftSize) {
+            replaceAt(t->left, k, std::move(text));
+            update(t);
+            return;
+        }
+        if (k >= leftSize + t->weight()) {
+            replaceAt(t->right, k - leftSize - t->weight(), std::move(text));
+            update(t);
+            return;
+        }
+        if (t->runCount == 0) {
+            if (text) t->text = std::move(text);
+            else slot = merge(std::move(t->left), std::move(t->right));
+            return;
+        }
+        size_t cut = k - leftSize;
+        NodePtr after = (cut + 1 < t->runCount) ? piece(*t, cut + 1, t->runCount - cut - 1, nullptr) : nullptr;
+        if (text) after = merge(leaf(std::move(text), t->priority), std::move(after));
+        after = merge(std::move(after), std::move(t->right));
+        if (cut == 0) {
+            slot = merge(std::move(t->left), std::move(after));
+            return;
+        }
+        t->runCount = cut;
+        t->right = std::move(after);
+        update(t);
+    }
+
+public:
+    // Kelas Builder membangun rope dari potongan berurutan dalam O(n) (algoritme
+    // Cartesian tree dengan stack di sepanjang tulang punggung kanan). Prioritas
+    // diberikan pemanggil, misalnya disalin dari treap lain yang bentuknya sama.
+    class Builder {
+    private:
+        std::vector<NodePtr> spine; // Tulang punggung kanan, akar di depan
+
+        // Ukuran dihitung dari bawah; subtree kanan diproses secara iteratif agar
+        // rantai kanan yang panjang tidak membuat rekursi dalam
+        static void computeSizes(Node* node) {
+            std::vector<Node*> chain;
+            for (; node != nullptr; node = node->right.get()) {
+                chain.push_back(node);
+                computeSizes(node->left.get());
+            }
+            size_t below = 0;
+            for (size_t i = chain.size(); i-- > 0; ) {
+                chain[i]->size = chain[i]->weight() + sizeOf(chain[i]->left) + below;
+                below = chain[i]->size;
+            }
+        }
+
+        void push(NodePtr node) {
+            NodePtr last;
+            while (!spine.empty() && spine.back()->priority < node->priority) {
+                last = std::move(spine.back());
+                spine.pop_back();
+            }
+            node->left = std::move(last);
+            if (!spine.empty()) spine.back()->right = node;
+            spine.push_back(std::move(node));
+        }
+
+    public:
+        void addText(unsigned int priority, std::string_view text) {
+            push(leaf(std::make_shared<const std::string>(text), priority));
+        }
+
+        void addRun(unsigned int priority, size_t sourceLine, size_t count) {
+            NodePtr node = std::make_shared<Node>();
+            node->priority = priority;
+            node->runCount = count;
+            node->sourceLine = sourceLine;
+            push(std::move(node));
+        }
+
+        NodePtr finish() {
+            if (spine.empty()) return nullptr;
+            NodePtr result = spine.front();
+            spine.clear();
+            computeSizes(result.get());
+            return result;
+        }
+    };
+
+    PersistentRope() : number(0), seed(2891336453u) {}
+
+    size_t lineCount() const { return sizeOf(root); }
+    uint64_t version() const { return number; }
+
+    // Fungsi untuk mengganti seluruh isi rope (hasil Builder) beserta sumber run-nya
+    void reset(NodePtr built, std::shared_ptr<const Source> file) {
+        root = std::move(built);
+        source = std::move(file);
+        number++;
+    }
+
+    // Fungsi untuk mengosongkan rope. Snapshot yang sudah diambil tidak terpengaruh.
+    void clear() {
+        reset(nullptr, nullptr);
+    }
+
+    // Fungsi untuk mengambil snapshot versi saat ini dalam O(1)
+    Snapshot snapshot() const {
+        return Snapshot(root, source, number);
+    }
+
+    // Fungsi untuk menyisipkan baris pada posisi tertentu (0 <= position <= lineCount)
+    void insert(size_t position, std::string_view text) {
+        insertAt(root, position, leaf(std::make_shared<const std::string>(text), nextPriority()));
+        number++;
+    }
+
+    // Fungsi untuk menghapus baris pada posisi tertentu
+    void erase(size_t position) {
+        if (position >= sizeOf(root)) return;
+        replaceAt(root, position, nullptr);
+        number++;
+    }
+
+    // Fungsi untuk mengganti teks baris pada posisi tertentu
+    void assign(size_t position, std::string_view text) {
+        if (position >= sizeOf(root)) return;
+        replaceAt(root, position, std::make_shared<const std::string>(text));
+        number++;
+    }
+};
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+
+// Kelas Profiler mencatat, untuk setiap jenis operasi, jumlah panggilan, latensi total
+// dan maksimum, jumlah node yang ditelusuri, serta byte yang dialokasikan. Sebuah
+// operasi diukur dengan membuat Profiler::Scope di awal fungsinya. Selama profiler
+// nonaktif, Scope hanya memeriksa satu flag dan tidak membaca jam.
+//
+// Node dihitung oleh kode penelusuran lewat visitNodes (satu penjumlahan tanpa cabang),
+// byte dibaca dari penghitung alokasi milik pemanggil. Keduanya dicatat sebagai selisih
+// antara awal dan akhir Scope, jadi pengukuran bersarang bersifat inklusif: undo juga
+// menghitung insertLine yang dipanggilnya.
+class Profiler {
+public:
+    struct OperationStats {
+        const char* name;
+        uint64_t calls;
+        uint64_t totalNanoseconds;
+        uint64_t maxNanoseconds;
+        uint64_t nodesVisited;
+        uint64_t bytesAllocated;
+    };
+
+    // Kelas Scope mengukur satu panggilan operasi dari konstruksi sampai destruksi
+    class Scope {
+    private:
+        Profiler* profiler; // nullptr jika profiler nonaktif saat Scope dibuat
+        int operation;
+        uint64_t nodesAtStart;
+        uint64_t bytesAtStart;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        Scope(Profiler& owner, int operation) : profiler(owner.enabled ? &owner : nullptr), operation(operation) {
+            if (profiler == nullptr) return;
+            nodesAtStart = owner.nodes;
+            bytesAtStart = owner.bytes();
+            start = std::chrono::steady_clock::now();
+        }
+
+        ~Scope() {
+            if (profiler == nullptr) return;
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+            profiler->record(operation, (uint64_t)elapsed.count(), profiler->nodes - nodesAtStart,
+                             profiler->bytes() - bytesAtStart);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    std::vector<OperationStats> stats; // Indeks = nomor operasi
+    bool enabled;
+    uint64_t nodes;                    // Total node yang ditelusuri sejak awal
+    const size_t* byteCounter;         // Penghitung byte teralokasi milik pemanggil (boleh nullptr)
+
+    uint64_t bytes() const {
+        return (byteCounter != nullptr) ? *byteCounter : 0;
+    }
+
+    void record(int operation, uint64_t nanoseconds, uint64_t visited, uint64_t allocated) {
+        OperationStats& entry = stats[operation];
+        entry.calls++;
+        entry.totalNanoseconds += nanoseconds;
+        if (nanoseconds > entry.maxNanoseconds) entry.maxNanoseconds = nanoseconds;
+        entry.nodesVisited += visited;
+        entry.bytesAllocated += allocated;
+    }
+
+public:
+    // Konstruktor dengan nama setiap operasi (names[i] untuk operasi nomor i)
+    Profiler(const char* const* names, int count) : enabled(false), nodes(0), byteCounter(nullptr) {
+        stats.resize(count);
+        for (int i = 0; i < count; i++) stats[i] = OperationStats{ names[i], 0, 0, 0, 0, 0 };
+    }
+
+    void setEnabled(bool value) { enabled = value; }
+    bool isEnabled() const { return enabled; }
+
+    // Fungsi untuk memakai penghitung byte teralokasi (harus hanya bertambah)
+    void setByteCounter(const size_t* counter) { byteCounter = counter; }
+
+    // Fungsi untuk mencatat node yang ditelusuri; cukup murah untuk dipanggil di loop
+    void visitNodes(uint64_t count) { nodes += count; }
+
+    // Fungsi untuk mengosongkan semua statistik
+    void reset() {
+        for (OperationStats& entry : stats) {
+            entry.calls = entry.totalNanoseconds = entry.maxNanoseconds = entry.nodesVisited = entry.bytesAllocated = 0;
+        }
+    }
+
+    bool hasData() const {
+        for (const OperationStats& entry : stats) {
+            if (entry.calls > 0) return true;
+        }
+        return false;
+    }
+
+    const std::vector<OperationStats>& operations() const { return stats; }
+
+    // Fungsi untuk menulis laporan, diurutkan dari waktu total terbesar. Kolom
+    // node/panggilan yang besar menandakan penelusuran O(n).
+    void report(std::ostream& out) const {
+        std::vector<const OperationStats*> rows;
+        for (const OperationStats& entry : stats) {
+            if (entry.calls > 0) rows.push_back(&entry);
+        }
+        if (rows.empty()) {
+            out << "Belum ada operasi yang tercatat." << std::endl;
+            return;
+        }
+        std::sort(rows.begin(), rows.end(), [](const OperationStats* a, const OperationStats* b) {
+            return a->totalNanoseconds > b->totalNanoseconds;
+        });
+
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::left << std::setw(22) << "Operasi" << std::right << std::setw(11) << "Panggilan"
+            << std::setw(12) << "Total ms" << std::setw(12) << "Rata2 us" << std::setw(12) << "Maks us"
+            << std::setw(15) << "Node/panggil" << std::setw(15) << "Byte/panggil" << "\n";
+        out << std::fixed;
+        for (const OperationStats* entry : rows) {
+            double calls = (double)entry->calls;
+            out << std::left << std::setw(22) << entry->name << std::right << std::setw(11) << entry->calls
+                << std::setprecision(3) << std::setw(12) << entry->totalNanoseconds / 1e6
+                << std::setprecision(2) << std::setw(12) << entry->totalNanoseconds / 1e3 / calls
+                << std::setw(12) << entry->maxNanoseconds / 1e3
+                << std::setprecision(1) << std::setw(15) << entry->nodesVisited / calls
+                << std::setw(15) << entry->bytesAllocated / calls << "\n";
+        }
+        out.flush();
+        out.flags(flags);
+        out.precision(precision);
+    }
+};
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+// Kelas Renderer menampilkan jendela (viewport) beberapa baris di sekitar kursor. Satu
+// frame disusun di buffer yang dialokasikan sekali lalu dikirim dengan satu kali write.
+//
+// Jika output adalah terminal ANSI, viewport dipasang tetap di bagian atas layar dan
+// menu bergulir di bawahnya (scroll region); setiap frame hanya menulis ulang baris
+// yang isinya berbeda dari frame sebelumnya. Untuk output lain (pipe atau file) tidak
+// ada layar yang bisa diperbarui, jadi setiap frame dicetak utuh sebagai teks biasa
+// dengan format yang sama seperti sebelumnya: "nomor: teks" per baris.
+class Renderer {
+public:
+    static const int DEFAULT_HEIGHT = 20; // Jumlah baris viewport bawaan
+
+private:
+    static const size_t FLUSH_SIZE = 64 * 1024; // Buffer listing dikirim setiap kali sebesar ini
+    static const int MENU_ROWS = 6;             // Baris minimal yang disisakan untuk menu
+
+    std::string output;               // Buffer satu frame
+    std::vector<std::string> pending; // Baris frame yang sedang disusun (kapasitasnya dipakai ulang)
+    std::vector<std::string> screen;  // Baris yang saat ini tampil di layar (mode terminal)
+    int height;                       // Jumlah baris viewport yang diminta
+    int top;                          // Nomor baris dokumen (0-based) teratas di viewport
+    int rowCount;                     // Jumlah baris yang sudah ditambahkan ke frame
+    bool terminal;                    // true jika output terminal ANSI
+    int screenRows;                   // Ukuran terminal saat scroll region dipasang (0 = belum)
+    int screenColumns;
+
+    // Fungsi untuk mengirim seluruh isi buffer ke stdout. Isi cout yang belum terkirim
+    // di-flush lebih dulu agar urutan pesan tetap terjaga.
+    static void writeAll(const std::string& data) {
+        std::cout.flush();
+        const char* p = data.data();
+        size_t left = data.size();
+        while (left > 0) {
+#ifdef _WIN32
+            int written = _write(1, p, (unsigned int)left);
+#else
+            ssize_t written = ::write(STDOUT_FILENO, p, left);
+#endif
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return;
+            p += written;
+            left -= (size_t)written;
+        }
+    }
+
+    static void appendNumber(std::string& out, long long value) {
+        char digits[24];
+        int length = 0;
+        do {
+            digits[length++] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (length > 0) out.push_back(digits[--length]);
+    }
+
+    // Fungsi untuk menulis satu baris "nomor: teks" dengan tanda kurung siku di sekitar
+    // teks [markStart, markStart + markLength) jika markStart >= 0
+    static void formatRow(std::string& out, int lineNumber, std::string_view text, int markStart, int markLength) {
+        appendNumber(out, lineNumber);
+        out.append(": ", 2);
+        if (markStart < 0) {
+            out.append(text.data(), text.size());
+            return;
+        }
+        out.append(text.data(), markStart);
+        out.push_back('[');
+        out.append(text.data() + markStart, markLength);
+        out.push_back(']');
+        out.append(text.data() + markStart + markLength, text.size() - markStart - markLength);
+    }
+
+    // Fungsi untuk menulis keterangan posisi viewport, misalnya "[Baris 41-60 dari 1000]"
+    void formatStatus(std::string& out, int lineCount) const {
+        out.append("[Baris ");
+        appendNumber(out, rowCount > 0 ? top + 1 : 0);
+        out.push_back('-');
+        appendNumber(out, top + rowCount);
+        out.append(" dari ");
+        appendNumber(out, lineCount);
+        out.push_back(']');
+    }
+
+    // Fungsi untuk membaca ukuran terminal; false jika tidak bisa dipakai untuk mode terminal
+    static bool terminalSize(int& rows, int& columns) {
+#ifdef _WIN32
+        (void)rows;
+        (void)columns;
+        return false;
+#else
+        struct winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || size.ws_col == 0) return false;
+        rows = size.ws_row;
+        columns = size.ws_col;
+        return true;
+#endif
+    }
+
+    // Fungsi untuk memotong baris agar muat dalam satu baris layar (tanpa memotong
+    // di tengah karakter UTF-8)
+    static void clip(std::string& text, int columns) {
+        if ((int)text.size() < columns) return;
+        size_t cut = columns > 1 ? columns - 1 : 0;
+        while (cut > 0 && ((unsigned char)text[cut] & 0xC0) == 0x80) cut--;
+        text.resize(cut);
+    }
+
+    // Fungsi untuk memasang scroll region: baris 1..viewport untuk teks, satu baris
+    // keterangan, lalu sisanya untuk menu. Layar dibersihkan, jadi cache baris diisi
+    // dengan baris kosong.
+    void setupScreen(int rows, int columns, int viewport) {
+        screenRows = rows;
+        screenColumns = columns;
+        screen.assign(viewport + 1, std::string());
+        output.append("\x1b[H\x1b[2J\x1b[");
+        appendNumber(output, viewport + 2);
+        output.push_back(';');
+        appendNumber(output, rows);
+        output.append("r\x1b[");
+        appendNumber(output, rows);
+        output.append(";1H");
+    }
+
+    // Fungsi untuk melepas scroll region (kembali ke layar biasa)
+    void releaseScreen() {
+        if (screenRows == 0) return;
+        output.append("\x1b[r\x1b[");
+        appendNumber(output, screenRows);
+        output.append(";1H\n");
+        screenRows = screenColumns = 0;
+        screen.clear();
+    }
+
+    // Fungsi untuk mendapatkan tinggi viewport yang muat di terminal (0 jika tidak muat)
+    int fittingHeight(int rows) const {
+        int viewport = height;
+        if (viewport > rows - MENU_ROWS - 1) viewport = rows - MENU_ROWS - 1;
+        return viewport >= 3 ? viewport : 0;
+    }
+
+    void endTerminalFrame(int lineCount, int rows, int columns) {
+        int viewport = fittingHeight(rows);
+        if (rows != screenRows || columns != screenColumns || (int)screen.size() != viewport + 1) {
+            setupScreen(rows, columns, viewport);
+        }
+        if ((int)pending.size() < viewport + 1) pending.resize(viewport + 1);
+
+        output.append("\x1b" "7"); // Simpan posisi kursor menu
+        for (int i = 0; i <= viewport; i++) {
+            std::string& text = pending[i];
+            if (i == viewport) {
+                text.clear();
+                formatStatus(text, lineCount);
+            }
+            else if (i >= rowCount) {
+                text.clear(); // Di bawah akhir dokumen
+            }
+            clip(text, columns);
+            if (text == screen[i]) continue; // Baris tidak berubah, tidak dikirim ulang
+            output.append("\x1b[");
+            appendNumber(output, i + 1);
+            output.append(";1H\x1b[2K");
+            output.append(text);
+            screen[i].swap(text);
+        }
+        output.append("\x1b" "8"); // Kembali ke posisi kursor menu
+    }
+
+public:
+    explicit Renderer(int height = DEFAULT_HEIGHT)
+        : height(height > 0 ? height : DEFAULT_HEIGHT), top(0), rowCount(0), terminal(false), screenRows(0), screenColumns(0) {
+        output.reserve(FLUSH_SIZE);
+#ifndef _WIN32
+        const char* term = getenv("TERM");
+        terminal = isatty(STDOUT_FILENO) && term != nullptr && strcmp(term, "dumb") != 0;
+#endif
+    }
+
+    // Destruktor mengembalikan terminal ke layar biasa jika scroll region terpasang
+    ~Renderer() {
+        output.clear();
+        releaseScreen();
+        if (!output.empty()) writeAll(output);
+    }
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    // Fungsi untuk mendapatkan jumlah baris viewport yang akan disusun frame berikutnya
+    int viewportHeight() const {
+        if (!terminal) return height;
+        int rows = 0;
+        int columns = 0;
+        if (!terminalSize(rows, columns)) return height;
+        int viewport = fittingHeight(rows);
+        return viewport > 0 ? viewport : height;
+    }
+
+    // Fungsi untuk melupakan isi layar yang tercatat, misalnya setelah Renderer lain
+    // menggambar di terminal yang sama; frame berikutnya menggambar ulang seluruh layar
+    void invalidate() {
+        screenRows = screenColumns = 0;
+        screen.clear();
+    }
+
+    // Fungsi untuk menggeser viewport seperlunya agar cursorLine terlihat. Selama kursor
+    // masih di dalam viewport, posisinya tidak berubah sehingga baris lain tidak perlu
+    // digambar ulang; jika keluar, kursor diletakkan di tengah viewport.
+    int scroll(int cursorLine, int lineCount) {
+        int visible = viewportHeight();
+        if (cursorLine < top || cursorLine >= top + visible) top = cursorLine - visible / 2;
+        if (top > lineCount - visible) top = lineCount - visible;
+        if (top < 0) top = 0;
+        return top;
+    }
+
+    // Fungsi untuk memulai frame baru
+    void beginFrame() {
+        rowCount = 0;
+        int visible = viewportHeight();
+        if ((int)pending.size() < visible + 1) pending.resize(visible + 1);
+    }
+
+    // Fungsi untuk menambahkan baris berikutnya di viewport (teks tidak disalin ke
+    // string sementara; langsung diformat ke buffer baris)
+    void addRow(int lineNumber, std::string_view text, int markStart = -1, int markLength = 0) {
+        if (rowCount + 1 >= (int)pending.size()) return;
+        std::string& row = pending[rowCount++];
+        row.clear();
+        formatRow(row, lineNumber, text, markStart, markLength);
+    }
+
+    // Fungsi untuk mengakhiri frame dan mengirimnya dengan satu kali write
+    void endFrame(int lineCount) {
+        output.clear();
+        int rows = 0;
+        int columns = 0;
+        if (terminal && terminalSize(rows, columns) && fittingHeight(rows) > 0) {
+            endTerminalFrame(lineCount, rows, columns);
+        }
+        else {
+            releaseScreen();
+            for (int i = 0; i < rowCount; i++) {
+                if (i > 0) output.push_back('\n');
+                output.append(pending[i]);
+            }
+            if (rowCount < lineCount) {
+                output.push_back('\n');
+                formatStatus(output, lineCount);
+            }
+            output.push_back('\n');
+        }
+        writeAll(output);
+    }
+
+    // Fungsi untuk mencetak seluruh dokumen (bukan hanya viewport) lewat buffer yang
+    // sama. Buffer dikirim setiap kali melewati FLUSH_SIZE, jadi dokumen sebesar apa pun
+    // tidak pernah disalin utuh ke memori.
+    void beginListing() {
+        output.clear();
+    }
+
+    void addListingRow(int lineNumber, std::string_view text, int markStart = -1, int markLength = 0) {
+        if (lineNumber > 1) output.push_back('\n');
+        formatRow(output, lineNumber, text, markStart, markLength);
+        if (output.size() >= FLUSH_SIZE) {
+            writeAll(output);
+            output.clear();
+        }
+    }
+
+    void endListing() {
+        output.push_back('\n');
+        writeAll(output);
+        output.clear();
+    }
+};
+
+#endif
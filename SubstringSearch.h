@@ -0,0 +1,200 @@
+#ifndef SUBSTRING_SEARCH_H
+#define SUBSTRING_SEARCH_H
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SUBSTRING_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+// Kelas SubstringSearch adalah kernel pencarian substring tervektorisasi. Setiap blok
+// 16 (SSE2) atau 32 (AVX2) byte dibandingkan sekaligus dengan byte pertama dan byte
+// terakhir kata kunci; hanya posisi yang cocok di kedua ujung yang diverifikasi dengan
+// memcmp. Kernel dipilih saat runtime sesuai kemampuan CPU, dengan versi skalar
+// (memchr + memcmp) sebagai cadangan untuk CPU atau compiler lain.
+class SubstringSearch {
+public:
+    enum Kernel { SCALAR, SSE2, AVX2 };
+
+    static constexpr size_t npos = std::string::npos;
+
+private:
+    typedef size_t (*FindFunction)(const char* text, size_t length, const char* needle, size_t needleLength);
+
+    std::string needle;    // Kata kunci yang dicari
+    Kernel kernelUsed;     // Kernel yang dipakai objek ini
+    FindFunction function; // Implementasi kernel tersebut
+
+    // Fungsi untuk mencari dengan memchr pada byte pertama lalu memcmp sisanya
+    static size_t findScalar(const char* text, size_t length, const char* needle, size_t needleLength) {
+        if (needleLength == 0) return 0;
+        if (length < needleLength) return npos;
+        const char* cursor = text;
+        const char* last = text + (length - needleLength);
+        while (cursor <= last) {
+            const char* candidate = static_cast<const char*>(memchr(cursor, needle[0], last - cursor + 1));
+            if (candidate == nullptr) return npos;
+            if (memcmp(candidate + 1, needle + 1, needleLength - 1) == 0) return candidate - text;
+            cursor = candidate + 1;
+        }
+        return npos;
+    }
+
+#ifdef SUBSTRING_SEARCH_X86
+    // Fungsi untuk memverifikasi kandidat dari bitmask (bit ke-i = posisi block + i)
+    static size_t verifyCandidates(unsigned int mask, const char* block, const char* text,
+                                   const char* needle, size_t needleLength) {
+        while (mask != 0) {
+            unsigned int bit = __builtin_ctz(mask);
+            if (memcmp(block + bit + 1, needle + 1, needleLength - 2) == 0) return (block + bit) - text;
+            mask &= mask - 1;
+        }
+        return npos;
+    }
+
+    __attribute__((target("sse2")))
+    static size_t findSSE2(const char* text, size_t length, const char* needle, size_t needleLength) {
+        if (needleLength < 2 || length < needleLength + 16) return findScalar(text, length, needle, needleLength);
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+        size_t i = 0;
+        for (; i + needleLength - 1 + 16 <= length; i += 16) {
+            __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + needleLength - 1));
+            __m128i equal = _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast));
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(equal);
+            if (mask != 0) {
+                size_t found = verifyCandidates(mask, text + i, text, needle, needleLength);
+                if (found != npos) return found;
+            }
+        }
+        size_t rest = findScalar(text + i, length - i, needle, needleLength);
+        return (rest != npos) ? i + rest : npos;
+    }
+
+    __attribute__((target("avx2")))
+    static size_t findAVX2(const char* text, size_t length, const char* needle, size_t needleLength) {
+        if (needleLength < 2 || length < needleLength + 32) return findSSE2(text, length, needle, needleLength);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needleLength - 1]);
+        size_t i = 0;
+        for (; i + needleLength - 1 + 32 <= length; i += 32) {
+            __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+            __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + needleLength - 1));
+            __m256i equal = _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast));
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(equal);
+            if (mask != 0) {
+                size_t found = verifyCandidates(mask, text + i, text, needle, needleLength);
+                if (found != npos) return found;
+            }
+        }
+        size_t rest = findScalar(text + i, length - i, needle, needleLength);
+        return (rest != npos) ? i + rest : npos;
+    }
+#endif
+
+    static FindFunction functionFor(Kernel kernel) {
+#ifdef SUBSTRING_SEARCH_X86
+        if (kernel == AVX2) return findAVX2;
+        if (kernel == SSE2) return findSSE2;
+#endif
+        (void)kernel;
+        return findScalar;
+    }
+
+public:
+    // Konstruktor dengan kernel terbaik yang didukung CPU
+    explicit SubstringSearch(std::string_view needle) : SubstringSearch(needle, bestKernel()) {}
+
+    // Konstruktor dengan kernel tertentu (turun ke skalar jika tidak didukung)
+    SubstringSearch(std::string_view needle, Kernel kernel) : needle(needle) {
+        kernelUsed = supported(kernel) ? kernel : SCALAR;
+        function = functionFor(kernelUsed);
+    }
+
+    // Fungsi untuk memeriksa apakah CPU ini mendukung sebuah kernel
+    static bool supported(Kernel kernel) {
+#ifdef SUBSTRING_SEARCH_X86
+        if (kernel == AVX2) return __builtin_cpu_supports("avx2");
+        if (kernel == SSE2) return __builtin_cpu_supports("sse2");
+#endif
+        return kernel == SCALAR;
+    }
+
+    // Fungsi untuk memilih kernel tercepat yang didukung (dihitung sekali saja)
+    static Kernel bestKernel() {
+        static const Kernel best = supported(AVX2) ? AVX2 : (supported(SSE2) ? SSE2 : SCALAR);
+        return best;
+    }
+
+    static const char* kernelName(Kernel kernel) {
+        switch (kernel) {
+            case AVX2: return "AVX2";
+            case SSE2: return "SSE2";
+            default: return "skalar";
+        }
+    }
+
+    Kernel kernel() const { return kernelUsed; }
+    const std::string& pattern() const { return needle; }
+
+    // Fungsi untuk mencari kemunculan pertama di text[0, length); npos jika tidak ada
+    size_t find(const char* text, size_t length) const {
+        return function(text, length, needle.data(), needle.size());
+    }
+
+    // Fungsi untuk mencari kemunculan pertama mulai dari offset from (seperti string::find)
+    size_t find(std::string_view text, size_t from = 0) const {
+        if (from > text.size()) return npos;
+        size_t found = find(text.data() + from, text.size() - from);
+        return (found != npos) ? from + found : npos;
+    }
+
+    // Fungsi untuk mencari kemunculan pertama mulai dari offset from; length diisi dengan
+    // panjang kecocokan (antarmuka yang sama dengan PatternSearch::match)
+    size_t match(std::string_view text, size_t from, size_t& length) const {
+        if (needle.empty()) return npos;
+        length = needle.size();
+        return find(text, from);
+    }
+
+    // Fungsi untuk memindai potongan teks berisi banyak baris ('\n' sebagai pemisah,
+    // '\r' sebelum '\n' bukan bagian baris) dalam satu kali jalan. visit(baris, kolom, panjang)
+    // dipanggil untuk setiap kemunculan yang tidak saling tumpang tindih, dengan baris
+    // dihitung relatif terhadap awal potongan. Kata kunci yang memuat '\n' tidak akan
+    // pernah cocok karena tidak ada baris yang memuatnya.
+    template <typename Visitor>
+    void scanLines(const char* chunk, size_t length, Visitor visit) const {
+        if (needle.empty() || needle.find('\n') != std::string::npos) return;
+        bool endsWithCR = needle.back() == '\r';
+        size_t line = 0;      // Nomor baris dari lineBegin
+        size_t lineBegin = 0; // Offset awal baris yang sedang dihitung
+        size_t offset = 0;
+        while (offset < length) {
+            size_t found = find(chunk + offset, length - offset);
+            if (found == npos) return;
+            size_t match = offset + found;
+
+            // Maju ke baris yang memuat match dengan menghitung '\n' di antaranya
+            const char* newline;
+            while ((newline = static_cast<const char*>(memchr(chunk + lineBegin, '\n', match - lineBegin))) != nullptr) {
+                line++;
+                lineBegin = (newline - chunk) + 1;
+            }
+
+            size_t end = match + needle.size();
+            if (endsWithCR && (end == length || chunk[end] == '\n')) {
+                offset = match + 1; // '\r' di akhir baris dibuang oleh pembacaan baris
+                continue;
+            }
+            visit(line, match - lineBegin, needle.size());
+            offset = end;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef TEXT_STATS_H
+#define TEXT_STATS_H
+
+#include <string_view>
+#include <cstddef>
+
+// Struktur TextStats menyimpan jumlah kata, codepoint UTF-8, dan byte dari teks baris
+// (tanpa akhir baris). Akhir baris selalu memisahkan kata, jadi statistik sebuah
+// dokumen adalah jumlah statistik setiap barisnya dan bisa diperbarui dengan selisih
+// setiap kali teks berubah. Kata adalah deretan byte bukan spasi (seperti wc -w);
+// codepoint dihitung dari byte yang bukan byte lanjutan UTF-8 (10xxxxxx).
+//
+// Nilainya bertanda agar satu TextStats juga bisa menyimpan selisih.
+struct TextStats {
+    static constexpr size_t BLOCK = 64; // Byte per blok di of(); hitungan per blok muat di 8 bit
+
+    long long words = 0;
+    long long codepoints = 0;
+    long long bytes = 0;
+
+    static bool isSpace(char c) {
+        return (c == ' ') | ((unsigned char)(c - '\t') <= '\r' - '\t');
+    }
+
+    static bool isLeadByte(char c) {
+        return ((unsigned char)c & 0xC0) != 0x80;
+    }
+
+    // Fungsi untuk menghitung statistik sepotong teks dalam satu kali jalan. Awal kata
+    // adalah byte bukan spasi yang didahului spasi. Teks diproses per blok BLOCK byte
+    // tanpa cabang dengan penghitung 8-bit, sehingga compiler bisa memakai SIMD untuk
+    // blok penuh; sisanya dihitung byte demi byte.
+    static TextStats of(std::string_view text) {
+        TextStats stats;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+        size_t length = text.size();
+        if (length == 0) return stats;
+        size_t words = !isSpace((char)bytes[0]);
+        size_t codepoints = isLeadByte((char)bytes[0]);
+        size_t i = 1;
+        for (; i + BLOCK <= length; i += BLOCK) {
+            unsigned char blockWords = 0;
+            unsigned char blockCodepoints = 0;
+            for (size_t j = 0; j < BLOCK; j++) {
+                blockWords += isSpace((char)bytes[i + j - 1]) & !isSpace((char)bytes[i + j]);
+                blockCodepoints += (bytes[i + j] & 0xC0) != 0x80;
+            }
+            words += blockWords;
+            codepoints += blockCodepoints;
+        }
+        for (; i < length; i++) {
+            words += isSpace((char)bytes[i - 1]) & !isSpace((char)bytes[i]);
+            codepoints += (bytes[i] & 0xC0) != 0x80;
+        }
+        stats.words = (long long)words;
+        stats.codepoints = (long long)codepoints;
+        stats.bytes = (long long)length;
+        return stats;
+    }
+
+    // Fungsi untuk menghitung selisih statistik ketika oldText di antara karakter before
+    // dan after diganti dengan newText. Cukup melihat kedua potongan dan dua karakter
+    // tetangganya, berapa pun panjang barisnya; awal dan akhir baris ditulis sebagai ' '.
+    static TextStats replaced(char before, std::string_view oldText, std::string_view newText, char after) {
+        TextStats removed = of(oldText);
+        TextStats added = of(newText);
+        added.words += boundaryWords(before, newText, after) - boundaryWords(before, oldText, after);
+        added.words -= removed.words;
+        added.codepoints -= removed.codepoints;
+        added.bytes -= removed.bytes;
+        return added;
+    }
+
+    TextStats& operator+=(const TextStats& other) {
+        words += other.words;
+        codepoints += other.codepoints;
+        bytes += other.bytes;
+        return *this;
+    }
+
+    TextStats& operator-=(const TextStats& other) {
+        words -= other.words;
+        codepoints -= other.codepoints;
+        bytes -= other.bytes;
+        return *this;
+    }
+
+private:
+    // Fungsi untuk menghitung koreksi jumlah kata saat text diletakkan di antara before
+    // dan after: kata pertama text tidak baru jika before bukan spasi, dan kata yang
+    // dimulai di after menjadi baru jika text (atau before, jika text kosong) diakhiri spasi
+    static long long boundaryWords(char before, std::string_view text, char after) {
+        long long words = 0;
+        if (!text.empty() && !isSpace(text.front()) && !isSpace(before)) words--;
+        char last = text.empty() ? before : text.back();
+        if (!isSpace(after) && isSpace(last)) words++;
+        return words;
+    }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Kelas ThreadPool menjalankan tugas pada sekumpulan thread tetap. Thread dibuat sekali
+// saat konstruksi dan dipakai ulang untuk setiap operasi, sehingga biaya membuat thread
+// tidak dibayar setiap kali tugas paralel dijalankan.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;         // Thread pekerja
+    std::queue<std::function<void()>> tasks;  // Antrian tugas yang belum diambil
+    std::mutex lock;                          // Melindungi tasks, active, dan stopping
+    std::condition_variable available;        // Sinyal: ada tugas baru atau pool berhenti
+    std::condition_variable idle;             // Sinyal: semua tugas selesai
+    size_t active;                            // Jumlah tugas yang sedang dikerjakan
+    bool stopping;                            // True saat destruktor meminta pekerja berhenti
+
+    // Fungsi utama setiap pekerja: ambil tugas dari antrian sampai pool dihentikan
+    void workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                available.wait(guard, [this]() { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return; // stopping dan antrian sudah kosong
+                task = std::move(tasks.front());
+                tasks.pop();
+                active++;
+            }
+            task();
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                active--;
+                if (active == 0 && tasks.empty()) idle.notify_all();
+            }
+        }
+    }
+
+public:
+    // Konstruktor; threadCount 0 berarti sebanyak inti CPU yang tersedia
+    explicit ThreadPool(size_t threadCount = 0) : active(0), stopping(false) {
+        if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+        for (size_t i = 0; i < threadCount; i++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    // Destruktor menunggu tugas yang tersisa selesai lalu menghentikan semua pekerja
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        available.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Fungsi untuk memasukkan tugas ke antrian
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push(std::move(task));
+        }
+        available.notify_one();
+    }
+
+    // Fungsi untuk menunggu sampai semua tugas yang sudah dimasukkan selesai
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        idle.wait(guard, [this]() { return active == 0 && tasks.empty(); });
+    }
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+// Kelas TrigramIndex memetakan setiap trigram (3 byte berurutan) ke daftar kunci baris
+// yang memuatnya. Kunci adalah bilangan yang mewakili satu versi teks sebuah baris:
+// ketika teks baris berubah, kuncinya dipensiunkan dan baris mendapat kunci baru.
+// Karena kunci baru selalu lebih besar dari semua kunci sebelumnya, setiap daftar tetap
+// terurut hanya dengan menambahkan di ujung, dan menghapus baris cukup dengan menandai
+// kuncinya pensiun. Entri yang pensiun dibersihkan sekaligus (compact) jika jumlahnya
+// sudah melebihi entri yang masih hidup.
+class TrigramIndex {
+private:
+    static const size_t COMPACT_MINIMUM = 4096; // Minimal kunci pensiun sebelum compact
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings; // Trigram -> kunci baris terurut
+    std::vector<bool> retired;  // retired[kunci] = kunci sudah tidak berlaku
+    uint32_t nextKey;           // Kunci baru berikutnya
+    size_t liveLines;           // Jumlah kunci yang masih berlaku
+    size_t retiredPending;      // Kunci pensiun yang entrinya belum dibersihkan
+    size_t entries;             // Total entri di semua daftar (termasuk yang pensiun)
+    std::vector<uint32_t> scratch; // Trigram baris yang sedang ditambahkan (dipakai ulang)
+
+    static uint32_t trigramAt(const char* p) {
+        return ((uint32_t)(unsigned char)p[0] << 16) | ((uint32_t)(unsigned char)p[1] << 8) | (unsigned char)p[2];
+    }
+
+    // Fungsi untuk mendapatkan trigram unik dari sebuah teks
+    static void trigramsOf(std::string_view text, std::vector<uint32_t>& result) {
+        result.clear();
+        for (size_t i = 0; i + 3 <= text.size(); i++) result.push_back(trigramAt(text.data() + i));
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+    }
+
+    // Fungsi untuk membuang entri kunci pensiun dari semua daftar
+    void compact() {
+        entries = 0;
+        for (auto it = postings.begin(); it != postings.end(); ) {
+            std::vector<uint32_t>& keys = it->second;
+            keys.erase(std::remove_if(keys.begin(), keys.end(), [this](uint32_t key) { return retired[key]; }), keys.end());
+            if (keys.empty()) {
+                it = postings.erase(it);
+                continue;
+            }
+            keys.shrink_to_fit();
+            entries += keys.size();
+            ++it;
+        }
+        retiredPending = 0;
+    }
+
+public:
+    // Konstruktor; kunci [0, firstFreeKey) dicadangkan untuk pemanggil (misalnya nomor
+    // baris file), kunci baru dimulai dari firstFreeKey
+    explicit TrigramIndex(uint32_t firstFreeKey = 0)
+        : retired(firstFreeKey, false), nextKey(firstFreeKey), liveLines(0), retiredPending(0), entries(0) {}
+
+    // Fungsi untuk menambahkan baris dengan kunci yang sudah dicadangkan. Harus dipanggil
+    // dengan kunci menaik dan sebelum addLine(text) pertama agar daftar tetap terurut.
+    void addLine(uint32_t key, std::string_view text) {
+        if (key >= retired.size()) retired.resize(key + 1, false);
+        trigramsOf(text, scratch);
+        for (uint32_t trigram : scratch) postings[trigram].push_back(key);
+        entries += scratch.size();
+        liveLines++;
+    }
+
+    // Fungsi untuk menambahkan baris dengan kunci baru; mengembalikan kunci tersebut
+    uint32_t addLine(std::string_view text) {
+        uint32_t key = nextKey++;
+        addLine(key, text);
+        return key;
+    }
+
+    // Fungsi untuk memensiunkan kunci baris yang dihapus atau teksnya berubah
+    void removeLine(uint32_t key) {
+        if (key >= retired.size() || retired[key]) return;
+        retired[key] = true;
+        liveLines--;
+        retiredPending++;
+        if (retiredPending >= COMPACT_MINIMUM && retiredPending > liveLines) compact();
+    }
+
+    // Fungsi untuk mencari kunci baris yang memuat semua trigram kata kunci (terurut).
+    // Mengembalikan false jika kata kunci terlalu pendek untuk dicari lewat indeks;
+    // hasilnya kandidat, jadi baris tetap harus diverifikasi dengan pencarian biasa.
+    bool candidates(std::string_view needle, std::vector<uint32_t>& result) const {
+        result.clear();
+        if (needle.size() < 3) return false;
+        std::vector<uint32_t> trigrams;
+        trigramsOf(needle, trigrams);
+
+        // Mulai dari daftar terpendek agar irisan sekecil mungkin sejak awal
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (uint32_t trigram : trigrams) {
+            auto found = postings.find(trigram);
+            if (found == postings.end()) return true; // Ada trigram yang tidak muncul sama sekali
+            lists.push_back(&found->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) {
+            return a->size() < b->size();
+        });
+
+        for (uint32_t key : *lists[0]) {
+            if (!retired[key]) result.push_back(key);
+        }
+        for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+            const std::vector<uint32_t>& keys = *lists[i];
+            result.erase(std::remove_if(result.begin(), result.end(), [&keys](uint32_t key) {
+                return !std::binary_search(keys.begin(), keys.end(), key);
+            }), result.end());
+        }
+        return true;
+    }
+
+    // Fungsi untuk membuang kapasitas cadangan daftar (dipanggil setelah membangun
+    // indeks sekaligus, saat daftar tidak lagi banyak bertambah)
+    void shrinkToFit() {
+        for (auto& posting : postings) posting.second.shrink_to_fit();
+    }
+
+    size_t lineCount() const { return liveLines; }
+    size_t trigramCount() const { return postings.size(); }
+    size_t entryCount() const { return entries; }
+    size_t staleKeyCount() const { return retiredPending; }
+
+    // Fungsi untuk memperkirakan memori indeks: isi daftar, node dan bucket hash map,
+    // serta bitmap kunci pensiun
+    size_t bytesUsed() const {
+        size_t bytes = sizeof(*this);
+        for (const auto& posting : postings) {
+            bytes += posting.second.capacity() * sizeof(uint32_t);
+            bytes += sizeof(posting) + 2 * sizeof(void*); // Node hash map (pasangan + pointer + hash)
+        }
+        bytes += postings.bucket_count() * sizeof(void*);
+        bytes += (retired.size() + 7) / 8;
+        return bytes;
+    }
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+
+// Kelas WorkStealingPool menjalankan tugas bernomor 0..count-1 yang ukurannya sangat
+// berbeda-beda (misalnya satu tugas per file). Setiap thread punya antrian sendiri yang
+// diisi satu blok nomor berurutan di awal, dan mengambil tugas dari depan antriannya
+// sendiri tanpa berebut dengan thread lain. Thread yang kehabisan tugas mencuri separuh
+// tugas dari belakang antrian thread lain, sehingga beberapa file besar yang kebetulan
+// jatuh ke satu thread tidak membuat thread lain menganggur.
+//
+// Tidak ada tugas baru selama pool berjalan, jadi thread berhenti begitu antriannya
+// kosong dan tidak ada lagi yang bisa dicuri. Thread dibuat di start() dan digabung di
+// wait(), karena pool ini dipakai untuk operasi yang jarang tetapi besar.
+class WorkStealingPool {
+private:
+    struct Queue {
+        std::mutex lock;         // Melindungi tasks (pemilik dan pencuri)
+        std::deque<size_t> tasks; // Pemilik mengambil dari depan, pencuri dari belakang
+    };
+
+    size_t threadCount;
+    std::vector<std::unique_ptr<Queue>> queues; // Satu antrian per thread
+    std::vector<std::thread> workers;
+    std::function<void(size_t)> work;           // Dipanggil sekali untuk setiap nomor tugas
+    std::atomic<size_t> stolen;                 // Jumlah tugas yang berpindah lewat pencurian
+
+    // Fungsi untuk mengambil tugas berikutnya dari antrian sendiri
+    bool popOwn(size_t self, size_t& task) {
+        Queue& queue = *queues[self];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty()) return false;
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    // Fungsi untuk mencuri separuh tugas (minimal satu) dari belakang antrian thread
+    // lain, mulai dari tetangga berikutnya. Mengembalikan false jika semua antrian kosong.
+    bool steal(size_t self) {
+        std::vector<size_t> taken;
+        for (size_t offset = 1; offset < threadCount && taken.empty(); offset++) {
+            Queue& victim = *queues[(self + offset) % threadCount];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            size_t count = (victim.tasks.size() + 1) / 2;
+            taken.assign(victim.tasks.end() - count, victim.tasks.end());
+            victim.tasks.erase(victim.tasks.end() - count, victim.tasks.end());
+        }
+        if (taken.empty()) return false;
+        stolen.fetch_add(taken.size(), std::memory_order_relaxed);
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        own.tasks.insert(own.tasks.end(), taken.begin(), taken.end());
+        return true;
+    }
+
+    // Fungsi utama setiap pekerja: kerjakan antrian sendiri, lalu curi sampai habis
+    void workerLoop(size_t self) {
+        size_t task;
+        while (true) {
+            if (popOwn(self, task)) {
+                work(task);
+            }
+            else if (!steal(self)) {
+                return;
+            }
+        }
+    }
+
+public:
+    // Konstruktor; threadCount 0 berarti sebanyak inti CPU yang tersedia
+    explicit WorkStealingPool(size_t threadCount = 0) : threadCount(threadCount), stolen(0) {
+        if (this->threadCount == 0) this->threadCount = std::thread::hardware_concurrency();
+        if (this->threadCount == 0) this->threadCount = 1;
+        for (size_t i = 0; i < this->threadCount; i++) queues.emplace_back(new Queue());
+    }
+
+    // Destruktor menunggu tugas yang masih berjalan
+    ~WorkStealingPool() {
+        wait();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const { return threadCount; }
+
+    // Fungsi untuk mendapatkan jumlah tugas yang dikerjakan oleh thread pencuri
+    size_t steals() const { return stolen.load(std::memory_order_relaxed); }
+
+    // Fungsi untuk mulai menjalankan task(0) .. task(count - 1) tanpa menunggu. Thread
+    // ke-i mendapat blok nomor ke-i, jadi setiap thread mulai dari tugas berurutan.
+    void start(size_t count, std::function<void(size_t)> task) {
+        wait();
+        work = std::move(task);
+        stolen.store(0, std::memory_order_relaxed);
+        size_t used = std::min(threadCount, count);
+        for (size_t i = 0; i < used; i++) {
+            size_t begin = count * i / used;
+            size_t end = count * (i + 1) / used;
+            for (size_t t = begin; t < end; t++) queues[i]->tasks.push_back(t);
+        }
+        for (size_t i = 0; i < used; i++) {
+            workers.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    // Fungsi untuk menunggu sampai semua tugas dari start() selesai
+    void wait() {
+        for (std::thread& worker : workers) worker.join();
+        workers.clear();
+        work = nullptr;
+    }
+};
+
+#endif
@@ -0,0 +1,241 @@
+// Benchmark untuk operasi LinkedList pada dokumen sintetis berukuran 1K sampai 10M baris.
+// Setiap operasi diukur satu per satu sehingga selain operasi/detik juga didapat latensi
+// p50 dan p99. Hasil ditulis ke stdout sebagai CSV (satu baris per ukuran dan operasi)
+// agar bisa dibandingkan antar-build; keterangan kemajuan ditulis ke stderr.
+//
+// Pemakaian: bench_editor [barisMaksimum] [jumlahOperasi]
+// Contoh   : bench_editor 10000000 20000 > hasil.csv
+//
+// Dokumen dibuat sebagai file sementara lalu dibuka lewat openFile, jalur yang sama
+// dengan yang dipakai editor untuk file besar. Kolom peak_rss_kb adalah puncak memori
+// proses sejak awal, jadi jalankan satu ukuran saja per proses jika butuh angka per ukuran.
+// Kolom arena_bytes adalah memori Arena (node dan teks baris) yang dipakai dokumen setelah
+// operasi; pada baris line_memory nilainya dibagi jumlah baris memberi memori per baris.
+#define EDITOR_NO_MAIN
+#include "main.cpp"
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Hasil pengukuran satu operasi
+struct BenchResult {
+    string operation;
+    size_t operations;
+    double totalMilliseconds;
+    double p50Nanoseconds;
+    double p99Nanoseconds;
+};
+
+// Fungsi untuk mendapatkan puncak memori (resident set) proses dalam KB
+static long long peakRssKilobytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return (long long)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // macOS melaporkan dalam byte
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Fungsi untuk menulis dokumen mirip log (deterministik agar hasil bisa dibandingkan)
+static bool writeDocument(const string& path, size_t lineCount) {
+    static const char* paths[] = { "/api/v1/items", "/api/v1/users", "/static/app.js", "/health" };
+    static const int statuses[] = { 200, 200, 200, 304, 404, 500 };
+    ofstream file(path, ios::binary);
+    if (!file) return false;
+    string line;
+    unsigned int seed = 2463534242u;
+    for (size_t i = 0; i < lineCount; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        line = "2024-01-01 12:00:00 INFO request id=" + to_string(i) + " path=" + paths[seed % 4] +
+               " status=" + to_string(statuses[(seed >> 8) % 6]) + " latency=" + to_string(seed % 997) + "ms\n";
+        file.write(line.data(), line.size());
+    }
+    return (bool)file;
+}
+
+// Fungsi untuk mendapatkan persentil dari sampel latensi (sampel akan diurutkan sebagian)
+static double percentile(vector<double>& samples, double fraction) {
+    if (samples.empty()) return 0.0;
+    size_t k = (size_t)(fraction * (samples.size() - 1));
+    nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+// Fungsi untuk mengukur count kali operation(i). between(i) dijalankan sebelum setiap
+// operasi tanpa ikut diukur (misalnya memindahkan kursor).
+template <typename Operation, typename Between>
+static BenchResult measure(const string& name, size_t count, Operation operation, Between between) {
+    vector<double> samples;
+    samples.reserve(count);
+    double total = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        between(i);
+        auto start = chrono::steady_clock::now();
+        operation(i);
+        chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+        samples.push_back(elapsed.count());
+        total += elapsed.count();
+    }
+    BenchResult result;
+    result.operation = name;
+    result.operations = count;
+    result.totalMilliseconds = total / 1e6;
+    result.p50Nanoseconds = percentile(samples, 0.50);
+    result.p99Nanoseconds = percentile(samples, 0.99);
+    return result;
+}
+
+template <typename Operation>
+static BenchResult measure(const string& name, size_t count, Operation operation) {
+    return measure(name, count, operation, [](size_t) {});
+}
+
+static void report(const LinkedList& editor, size_t lineCount, const BenchResult& result) {
+    double perSecond = (result.totalMilliseconds > 0.0) ? result.operations / (result.totalMilliseconds / 1000.0) : 0.0;
+    cout.clear();
+    cout << lineCount << ',' << result.operation << ',' << result.operations << ','
+         << fixed << setprecision(3) << result.totalMilliseconds << ',' << setprecision(0) << perSecond << ','
+         << result.p50Nanoseconds << ',' << result.p99Nanoseconds << ',' << peakRssKilobytes() << ','
+         << editor.getArenaBytesInUse() << endl;
+    cout.setstate(ios::badbit); // Pesan editor kembali disembunyikan
+}
+
+// Fungsi untuk memeriksa bahwa batas riwayat membuang grup undo secara utuh: transaksi
+// yang lebih besar dari batas harus tetap bisa di-undo sekaligus, sedangkan aksi lepas
+// sebelumnya yang terbuang dilaporkan lewat jumlah aksi yang dibuang.
+static bool checkGroupedHistoryBudget(LinkedList& editor) {
+    const string text = "2024-01-01 12:00:00 INFO baris transaksi pemeriksaan batas riwayat";
+    const int before = 5, grouped = 200;
+    const size_t budget = editor.getHistoryBudget();
+    editor.clear();
+    for (int i = 0; i < before; i++) editor.insertLine(i, text);
+    editor.setHistoryBudget(1024); // Jauh lebih kecil dari isi transaksi
+    editor.beginTransaction();
+    for (int i = 0; i < grouped; i++) editor.insertLine(before + i, text);
+    editor.commitTransaction();
+
+    bool ok = true;
+    if (editor.getHistoryEvicted() != (size_t)before) {
+        cerr << "Pemeriksaan batas riwayat gagal: " << editor.getHistoryEvicted() << " aksi dibuang, seharusnya "
+             << before << "." << endl;
+        ok = false;
+    }
+    editor.undo();
+    if (editor.getLineCount() != before) {
+        cerr << "Pemeriksaan batas riwayat gagal: undo transaksi menyisakan " << editor.getLineCount()
+             << " baris, seharusnya " << before << "." << endl;
+        ok = false;
+    }
+    editor.redo();
+    if (editor.getLineCount() != before + grouped) {
+        cerr << "Pemeriksaan batas riwayat gagal: redo transaksi menghasilkan " << editor.getLineCount()
+             << " baris, seharusnya " << before + grouped << "." << endl;
+        ok = false;
+    }
+    editor.setHistoryBudget(budget);
+    editor.clear();
+    return ok;
+}
+
+// Fungsi untuk menjalankan semua pengukuran pada dokumen berukuran lineCount baris
+static void benchmarkSize(LinkedList& editor, const string& path, size_t lineCount, size_t operations) {
+    cerr << "Dokumen " << lineCount << " baris..." << endl;
+    if (!writeDocument(path, lineCount)) {
+        cerr << "Gagal menulis dokumen sementara \"" << path << "\"." << endl;
+        return;
+    }
+    unsigned int seed = 88172645u;
+    auto random = [&seed](size_t limit) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return (int)(seed % (limit + 1));
+    };
+    const string text = "2024-01-01 12:00:00 INFO baris sisipan benchmark";
+
+    // Menyisipkan baris di awal, tengah, dan akhir dokumen
+    editor.openFile(path);
+    report(editor, lineCount, measure("insert_head", operations, [&](size_t) { editor.insertLine(0, text); }));
+    editor.openFile(path);
+    report(editor, lineCount, measure("insert_middle", operations, [&](size_t) { editor.insertLine(editor.getLineCount() / 2, text); }));
+    editor.openFile(path);
+    report(editor, lineCount, measure("insert_tail", operations, [&](size_t) { editor.insertLine(editor.getLineCount(), text); }));
+
+    // Menghapus baris di posisi acak (dibatasi agar dokumen kecil tidak habis)
+    editor.openFile(path);
+    size_t deletions = min(operations, lineCount / 2);
+    report(editor, lineCount, measure("delete_line", deletions, [&](size_t) { editor.deleteLine(random(editor.getLineCount() - 1)); }));
+
+    // Edit karakter pada baris-baris berurutan; kursor dipindah di luar pengukuran
+    editor.openFile(path);
+    report(editor, lineCount, measure("replace_char", operations, [&](size_t) { editor.replaceCurrentChar("#"); },
+                              [&](size_t i) { if (i > 0) editor.moveToNextLine(); }));
+    editor.openFile(path);
+    report(editor, lineCount, measure("delete_char", operations, [&](size_t) { editor.deleteCurrentChar(); },
+                              [&](size_t i) { if (i > 0) editor.moveToNextLine(); }));
+
+    // Pencarian dan penggantian seluruh dokumen (lebih sedikit putaran karena mahal)
+    size_t rounds = (lineCount <= 100000) ? 20 : 5;
+    editor.openFile(path);
+    report(editor, lineCount, measure("search", rounds, [&](size_t) { editor.searchAndHighlight("status=500"); }));
+    report(editor, lineCount, measure("replace_text", rounds, [&](size_t) { editor.replaceText("status=500", "status=503"); },
+                              [&](size_t) { editor.openFile(path); }));
+
+    // Dokumen yang seluruh barisnya berada di node (bukan di file): baris pendek 9-22
+    // karakter disisipkan di akhir, lalu dipindai berurutan oleh pencarian dan penggantian
+    editor.clear();
+    string shortLine;
+    report(editor, lineCount, measure("line_memory", lineCount, [&](size_t i) {
+        shortLine = "catatan " + to_string(i % 100000) + ((i & 1) ? " selesai" : "");
+        editor.insertLine((int)i, shortLine, false);
+    }));
+    report(editor, lineCount, measure("search_edited", rounds, [&](size_t) { editor.searchAndHighlight("catatan 777"); }));
+    report(editor, lineCount, measure("replace_edited", rounds, [&](size_t i) {
+        if (i % 2 == 0) editor.replaceText("selesai", "beres", false);
+        else editor.replaceText("beres", "selesai", false);
+    }));
+
+    // Riwayat dalam: operations sisipan acak lalu di-undo dan di-redo seluruhnya
+    editor.openFile(path);
+    for (size_t i = 0; i < operations; i++) editor.insertLine(random(editor.getLineCount()), text);
+    report(editor, lineCount, measure("undo", operations, [&](size_t) { editor.undo(); }));
+    report(editor, lineCount, measure("redo", operations, [&](size_t) { editor.redo(); }));
+
+    editor.clear();
+    remove(path.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxLines = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t operations = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 10000;
+    if (operations == 0) operations = 1;
+    const string path = "bench_editor.tmp";
+
+    LinkedList editor;
+    editor.setRendering(false);
+    editor.setJournaling(false); // Yang diukur operasi editor, bukan fsync jurnal
+    cout << "lines,operation,ops,total_ms,ops_per_sec,p50_ns,p99_ns,peak_rss_kb,arena_bytes" << endl;
+    cout.setstate(ios::badbit); // Pesan editor tidak ikut diukur dan tidak ditampilkan
+    if (!checkGroupedHistoryBudget(editor)) {
+        cout.clear();
+        return 1;
+    }
+
+    for (size_t lines = 1000; lines <= maxLines && lines <= 10000000; lines *= 10) {
+        benchmarkSize(editor, path, lines, operations);
+    }
+    cout.clear();
+    return 0;
+}
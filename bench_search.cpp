@@ -0,0 +1,115 @@
+// Micro-benchmark untuk kernel pencarian SubstringSearch dibandingkan dengan loop
+// string::find per baris yang sebelumnya dipakai searchAndHighlight dan replaceText.
+//
+// Pemakaian: bench_search [jumlahBaris] [kataKunci]
+// Contoh   : bench_search 1000000 "status=500"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "SubstringSearch.h"
+using namespace std;
+
+// Fungsi untuk membuat baris-baris mirip log (deterministik agar hasil bisa dibandingkan)
+static vector<string> generateLines(size_t count) {
+    static const char* paths[] = { "/api/v1/items", "/api/v1/users", "/static/app.js", "/health" };
+    static const int statuses[] = { 200, 200, 200, 304, 404, 500 };
+    vector<string> lines;
+    lines.reserve(count);
+    unsigned int seed = 2463534242u;
+    for (size_t i = 0; i < count; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        lines.push_back("2024-01-01 12:00:00 INFO request id=" + to_string(i) + " path=" + paths[seed % 4] +
+                        " status=" + to_string(statuses[(seed >> 8) % 6]) + " latency=" + to_string(seed % 997) + "ms");
+    }
+    return lines;
+}
+
+// Fungsi untuk menjalankan fungsi f beberapa kali dan mengembalikan waktu terbaik (ms)
+template <typename Function>
+static double bestOf(int rounds, Function f) {
+    double best = 1e300;
+    for (int i = 0; i < rounds; i++) {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+}
+
+static void report(const string& name, double ms, size_t bytes, size_t matches, double baseline) {
+    cout << left << setw(30) << name << right << fixed << setprecision(2)
+         << setw(10) << ms << " ms" << setw(10) << (bytes / (1024.0 * 1024.0)) / (ms / 1000.0) << " MB/s"
+         << setw(8) << baseline / ms << "x" << setw(12) << matches << " cocok" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t lineCount = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    string keyword = (argc > 2) ? argv[2] : "status=500";
+    const int rounds = 5;
+
+    vector<string> lines = generateLines(lineCount);
+    string buffer; // Baris yang sama dalam satu potongan bersambung, seperti file yang dipetakan
+    for (const string& line : lines) {
+        buffer += line;
+        buffer += '\n';
+    }
+
+    cout << "Baris: " << lineCount << ", ukuran: " << buffer.size() << " byte, kata kunci: \"" << keyword << "\"" << endl;
+    cout << "Kernel terbaik di CPU ini: " << SubstringSearch::kernelName(SubstringSearch::bestKernel()) << endl << endl;
+
+    // Acuan: string::find pada setiap baris
+    size_t expected = 0;
+    double baseline = bestOf(rounds, [&]() {
+        expected = 0;
+        for (const string& line : lines) {
+            size_t pos = 0;
+            while ((pos = line.find(keyword, pos)) != string::npos) {
+                expected++;
+                pos += keyword.length();
+            }
+        }
+    });
+    report("string::find per baris", baseline, buffer.size(), expected, baseline);
+
+    bool mismatch = false;
+    for (int k = SubstringSearch::SCALAR; k <= SubstringSearch::AVX2; k++) {
+        SubstringSearch::Kernel kernel = (SubstringSearch::Kernel)k;
+        if (!SubstringSearch::supported(kernel)) continue;
+        SubstringSearch search(keyword, kernel);
+
+        size_t perLine = 0;
+        double ms = bestOf(rounds, [&]() {
+            perLine = 0;
+            for (const string& line : lines) {
+                size_t pos = 0;
+                while ((pos = search.find(line, pos)) != SubstringSearch::npos) {
+                    perLine++;
+                    pos += keyword.length();
+                }
+            }
+        });
+        report(string(SubstringSearch::kernelName(kernel)) + " per baris", ms, buffer.size(), perLine, baseline);
+
+        size_t chunked = 0;
+        ms = bestOf(rounds, [&]() {
+            chunked = 0;
+            search.scanLines(buffer.data(), buffer.size(), [&](size_t, size_t, size_t) { chunked++; });
+        });
+        report(string(SubstringSearch::kernelName(kernel)) + " potongan multi-baris", ms, buffer.size(), chunked, baseline);
+
+        if (perLine != expected || chunked != expected) mismatch = true;
+    }
+
+    if (mismatch) {
+        cout << "\nPERINGATAN: jumlah kecocokan berbeda dengan string::find." << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,10 +1,576 @@
 #include <iostream>
 #include <string>
-#include <stack>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <utility>
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <memory>
+#include <climits>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "SubstringSearch.h"
+#include "PatternSearch.h"
+#include "ThreadPool.h"
+#include "TrigramIndex.h"
+#include "Renderer.h"
+#include "Profiler.h"
+#include "BackgroundSaver.h"
+#include "Journal.h"
+#include "PersistentRope.h"
+#include "GapBuffer.h"
+#include "WorkStealingPool.h"
+#include "TextStats.h"
+#include "CodepointIndex.h"
 using namespace std;
 
-// Struktur untuk menyimpan aksi yang dilakukan oleh pengguna
+// Kelas Arena adalah alokator slab untuk node baris beserta teksnya. Memori diambil
+// dari sistem dalam blok besar lalu dibagi menurut kelas ukuran; objek yang dibebaskan
+// masuk ke free list kelasnya untuk dipakai ulang. Seluruh memori dilepas sekaligus
+// lewat release(), tanpa membebaskan node satu per satu.
+class Arena {
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;   // Ukuran satu blok slab
+    static const size_t MAX_CLASS_SIZE = 32768;   // Di atas ini dialokasikan sebagai blok besar
+    static const int CLASS_COUNT = 23;            // 16..256 (kelipatan 16), lalu 512..32768
+
+    struct FreeSlot { FreeSlot* next; };
+
+    // Header untuk alokasi besar; disimpan tepat sebelum memori yang diberikan
+    struct alignas(16) LargeHeader {
+        LargeHeader* prev;
+        LargeHeader* next;
+        size_t size;
+    };
+
+    FreeSlot* freeLists[CLASS_COUNT]; // Free list untuk setiap kelas ukuran
+    vector<char*> blocks;             // Semua blok slab yang pernah diambil
+    char* cursor;                     // Posisi bebas berikutnya pada blok aktif
+    size_t remaining;                 // Sisa byte pada blok aktif
+    LargeHeader* largeList;           // Daftar alokasi besar yang masih hidup
+    size_t reserved;                  // Total byte yang diambil dari sistem
+    size_t inUse;                     // Total byte yang sedang dipakai objek
+    size_t allocatedTotal;            // Total byte yang pernah dialokasikan (hanya bertambah)
+
+    // Fungsi untuk menentukan kelas ukuran dari jumlah byte
+    static int classOf(size_t bytes) {
+        if (bytes <= 256) return bytes == 0 ? 0 : (int)((bytes - 1) / 16);
+        int index = 16;
+        size_t size = 512;
+        while (size < bytes) {
+            size <<= 1;
+            index++;
+        }
+        return index;
+    }
+
+    // Fungsi untuk mendapatkan ukuran sebenarnya dari sebuah kelas
+    static size_t classSize(int index) {
+        if (index < 16) return (size_t)(index + 1) * 16;
+        return (size_t)512 << (index - 16);
+    }
+
+public:
+    Arena() : cursor(nullptr), remaining(0), largeList(nullptr), reserved(0), inUse(0), allocatedTotal(0) {
+        for (int i = 0; i < CLASS_COUNT; i++) freeLists[i] = nullptr;
+    }
+
+    ~Arena() {
+        release();
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Fungsi untuk mengalokasikan memori (selalu sejajar 16 byte)
+    void* allocate(size_t bytes) {
+        if (bytes > MAX_CLASS_SIZE) {
+            LargeHeader* header = static_cast<LargeHeader*>(::operator new(sizeof(LargeHeader) + bytes));
+            header->prev = nullptr;
+            header->next = largeList;
+            header->size = bytes;
+            if (largeList != nullptr) largeList->prev = header;
+            largeList = header;
+            reserved += sizeof(LargeHeader) + bytes;
+            inUse += bytes;
+            allocatedTotal += bytes;
+            return header + 1;
+        }
+
+        int index = classOf(bytes);
+        size_t size = classSize(index);
+        inUse += size;
+        allocatedTotal += size;
+
+        // Pakai ulang slot yang pernah dibebaskan jika ada
+        if (freeLists[index] != nullptr) {
+            FreeSlot* slot = freeLists[index];
+            freeLists[index] = slot->next;
+            return slot;
+        }
+
+        // Ambil blok baru jika sisa blok aktif tidak cukup
+        if (remaining < size) {
+            cursor = static_cast<char*>(::operator new(BLOCK_SIZE));
+            blocks.push_back(cursor);
+            remaining = BLOCK_SIZE;
+            reserved += BLOCK_SIZE;
+        }
+        void* result = cursor;
+        cursor += size;
+        remaining -= size;
+        return result;
+    }
+
+    // Fungsi untuk mengembalikan memori ke free list kelasnya
+    void deallocate(void* pointer, size_t bytes) {
+        if (pointer == nullptr) return;
+        if (bytes > MAX_CLASS_SIZE) {
+            LargeHeader* header = static_cast<LargeHeader*>(pointer) - 1;
+            if (header->prev != nullptr) header->prev->next = header->next;
+            else largeList = header->next;
+            if (header->next != nullptr) header->next->prev = header->prev;
+            reserved -= sizeof(LargeHeader) + header->size;
+            inUse -= header->size;
+            ::operator delete(header);
+            return;
+        }
+
+        int index = classOf(bytes);
+        FreeSlot* slot = static_cast<FreeSlot*>(pointer);
+        slot->next = freeLists[index];
+        freeLists[index] = slot;
+        inUse -= classSize(index);
+    }
+
+    // Fungsi untuk melepas seluruh memori arena sekaligus
+    void release() {
+        for (char* block : blocks) ::operator delete(block);
+        blocks.clear();
+        while (largeList != nullptr) {
+            LargeHeader* next = largeList->next;
+            ::operator delete(largeList);
+            largeList = next;
+        }
+        for (int i = 0; i < CLASS_COUNT; i++) freeLists[i] = nullptr;
+        cursor = nullptr;
+        remaining = 0;
+        reserved = 0;
+        inUse = 0;
+    }
+
+    size_t bytesReserved() const { return reserved; }
+    size_t bytesInUse() const { return inUse; }
+
+    // Fungsi untuk mendapatkan penghitung total byte teralokasi (dipakai Profiler)
+    const size_t* allocationCounter() const { return &allocatedTotal; }
+};
+
+// Kelas LineText menyimpan teks satu baris. Teks pendek (sampai INLINE_CAPACITY byte)
+// disimpan langsung di dalam objek, sehingga node dan teksnya menempati satu slot Arena
+// dan pemindaian baris tidak perlu mengikuti pointer kedua. Teks yang lebih panjang
+// dialokasikan dari Arena. Panjang dan kapasitas disimpan sebagai 32 bit dan teks tidak
+// diakhiri '\0', jadi seluruh objek hanya 40 byte.
+class LineText {
+public:
+    static const uint32_t INLINE_CAPACITY = 24;
+
+private:
+    Arena* arena;       // Arena sumber memori untuk teks panjang
+    uint32_t count;     // Panjang teks dalam byte
+    uint32_t capacity;  // Kapasitas; sama dengan INLINE_CAPACITY jika teks ada di local
+    union {
+        char* heap;                    // Teks panjang (capacity > INLINE_CAPACITY)
+        char local[INLINE_CAPACITY];   // Teks pendek
+    };
+
+    bool isInline() const {
+        return capacity == INLINE_CAPACITY;
+    }
+
+    // Fungsi untuk memastikan kapasitas cukup untuk needed byte (isi lama dipertahankan)
+    void reserve(size_t needed) {
+        if (needed <= capacity) return;
+        size_t grown = max(needed, (size_t)capacity + capacity / 2);
+        grown = (grown + 15) & ~(size_t)15; // Kelas ukuran Arena berkelipatan 16
+        char* memory = static_cast<char*>(arena->allocate(grown));
+        memcpy(memory, data(), count);
+        if (!isInline()) arena->deallocate(heap, capacity);
+        heap = memory;
+        capacity = (uint32_t)grown;
+    }
+
+public:
+    LineText(string_view text, Arena* arena) : arena(arena), count(0), capacity(INLINE_CAPACITY) {
+        assign(text);
+    }
+
+    ~LineText() {
+        if (!isInline()) arena->deallocate(heap, capacity);
+    }
+
+    LineText(const LineText&) = delete;
+    LineText& operator=(const LineText&) = delete;
+
+    const char* data() const { return isInline() ? local : heap; }
+    char* data() { return isInline() ? local : heap; }
+    size_t size() const { return count; }
+    size_t length() const { return count; }
+    bool empty() const { return count == 0; }
+    char& operator[](size_t index) { return data()[index]; }
+    char operator[](size_t index) const { return data()[index]; }
+    operator string_view() const { return string_view(data(), count); }
+
+    // Fungsi untuk mengganti seluruh isi teks. text boleh menunjuk ke isi teks ini sendiri.
+    LineText& assign(string_view text) {
+        return replace(0, count, text.data(), text.size());
+    }
+
+    // Fungsi untuk mengganti length byte mulai dari position dengan text (seperti
+    // string::replace). text boleh menunjuk ke isi teks ini sendiri.
+    LineText& replace(size_t position, size_t length, const char* text, size_t textLength) {
+        const char* old = data();
+        if (!less<const char*>()(text, old) && less<const char*>()(text, old + count)) {
+            string copy(text, textLength); // Sumber akan tergeser atau dipindah oleh reserve
+            return replace(position, length, copy.data(), copy.size());
+        }
+        length = min(length, (size_t)count - position);
+        size_t newCount = count - length + textLength;
+        reserve(newCount);
+        char* target = data();
+        memmove(target + position + textLength, target + position + length, count - position - length);
+        if (textLength > 0) memcpy(target + position, text, textLength); // text boleh nullptr jika kosong
+        count = (uint32_t)newCount;
+        return *this;
+    }
+
+    LineText& replace(size_t position, size_t length, string_view text) {
+        return replace(position, length, text.data(), text.size());
+    }
+
+    // Fungsi untuk menyisipkan repeat salinan karakter c di position
+    LineText& insert(size_t position, size_t repeat, char c) {
+        reserve((size_t)count + repeat);
+        char* target = data();
+        memmove(target + position + repeat, target + position, count - position);
+        memset(target + position, c, repeat);
+        count += (uint32_t)repeat;
+        return *this;
+    }
+
+    // Fungsi untuk menghapus length byte mulai dari position
+    LineText& erase(size_t position, size_t length) {
+        length = min(length, (size_t)count - position);
+        char* target = data();
+        memmove(target + position, target + position + length, count - position - length);
+        count -= (uint32_t)length;
+        return *this;
+    }
+};
+
+// Kelas StringPool menyimpan string riwayat undo/redo yang sering berulang (kata kunci,
+// teks pengganti, dan teks lama REPLACE_PATTERN) cukup satu kali. Setiap string punya
+// id dan hitungan referensi; catatan riwayat hanya menyimpan id-nya, dan string dibuang
+// begitu catatan terakhir yang memakainya hilang.
+class StringPool {
+private:
+    struct Entry {
+        string text;       // Isi string
+        unsigned int refs; // Jumlah catatan yang memakai string ini (0 = slot kosong)
+    };
+
+    deque<Entry> entries;                         // deque agar alamat teks tidak berpindah
+    vector<unsigned int> freeIds;                 // Slot kosong yang bisa dipakai ulang
+    unordered_map<string_view, unsigned int> ids; // Teks -> id (kuncinya menunjuk ke entries)
+    size_t textBytes;                             // Total teks yang berada di luar objek string
+
+    // Fungsi untuk menghitung byte heap sebuah string (0 jika masih muat di buffer SSO)
+    static size_t heapBytes(const string& text) {
+        return text.capacity() > string().capacity() ? text.capacity() + 1 : 0;
+    }
+
+public:
+    StringPool() : textBytes(0) {}
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Fungsi untuk mendapatkan id sebuah string; string baru ditambahkan ke pool
+    unsigned int intern(string_view text) {
+        auto found = ids.find(text);
+        if (found != ids.end()) {
+            entries[found->second].refs++;
+            return found->second;
+        }
+        unsigned int id;
+        if (!freeIds.empty()) {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else {
+            id = (unsigned int)entries.size();
+            entries.push_back(Entry{string(), 0});
+        }
+        Entry& entry = entries[id];
+        entry.text.assign(text.data(), text.size());
+        entry.refs = 1;
+        textBytes += heapBytes(entry.text);
+        ids.emplace(string_view(entry.text), id);
+        return id;
+    }
+
+    // Fungsi untuk melepas satu referensi ke string
+    void release(unsigned int id) {
+        Entry& entry = entries[id];
+        if (--entry.refs > 0) return;
+        ids.erase(string_view(entry.text));
+        textBytes -= heapBytes(entry.text);
+        string().swap(entry.text);
+        freeIds.push_back(id);
+    }
+
+    string_view view(unsigned int id) const { return entries[id].text; }
+    size_t count() const { return ids.size(); }
+
+    // Fungsi untuk memperkirakan memori pool: slot, teks, serta node dan bucket hash map
+    size_t bytesUsed() const {
+        return entries.size() * sizeof(Entry) + freeIds.capacity() * sizeof(unsigned int) + textBytes
+             + ids.size() * (sizeof(pair<const string_view, unsigned int>) + 2 * sizeof(void*))
+             + ids.bucket_count() * sizeof(void*);
+    }
+};
+
+// Kelas MappedFile memetakan isi file ke memori (mmap) secara read-only. Saat dibuka,
+// yang dibangun hanya indeks offset baris yang jarang: offset awal setiap LINE_STRIDE
+// baris, sedangkan baris di antaranya dicari dengan memchr. Isi baris tidak pernah
+// disalin di sini; LinkedList membaca langsung dari pemetaan.
+class MappedFile {
+private:
+    static const size_t LINE_STRIDE = 64;        // Jarak antar-checkpoint dalam baris
+    static const size_t RELEASE_CHUNK = 16 << 20; // Halaman yang sudah dipindai dilepas per 16 MB
+
+    const char* bytes;          // Awal pemetaan (nullptr untuk file kosong)
+    size_t length;              // Ukuran file dalam byte
+    size_t lines;               // Jumlah baris dalam file
+    vector<size_t> checkpoints; // checkpoints[i] = offset awal baris ke-(i * LINE_STRIDE)
+#ifdef _WIN32
+    HANDLE fileHandle;          // Handle file yang dipetakan
+    HANDLE mappingHandle;       // Handle objek pemetaan
+#endif
+
+    // Fungsi untuk memberi tahu OS bahwa halaman [begin, end) tidak dibutuhkan lagi,
+    // agar pemindaian awal tidak membuat RSS ikut sebesar file
+    void releasePages(size_t begin, size_t end) {
+#ifndef _WIN32
+        long pageSize = sysconf(_SC_PAGESIZE);
+        begin -= begin % pageSize;
+        if (end > begin) madvise(const_cast<char*>(bytes) + begin, end - begin, MADV_DONTNEED);
+#else
+        (void)begin;
+        (void)end;
+#endif
+    }
+
+    // Fungsi untuk menghitung baris dan membangun checkpoint dalam satu kali pindai
+    void buildIndex() {
+        lines = 0;
+        checkpoints.clear();
+        if (length == 0) return;
+        checkpoints.push_back(0);
+        size_t released = 0;
+        const char* cursor = bytes;
+        const char* end = bytes + length;
+        while (cursor < end) {
+            const char* newline = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+            if (newline == nullptr) break;
+            cursor = newline + 1;
+            lines++;
+            if (lines % LINE_STRIDE == 0 && cursor < end) checkpoints.push_back(cursor - bytes);
+            if ((size_t)(cursor - bytes) - released >= RELEASE_CHUNK) {
+                releasePages(released, cursor - bytes);
+                released = cursor - bytes;
+            }
+        }
+        if (cursor < end) lines++; // Baris terakhir tanpa newline
+        releasePages(released, length);
+    }
+
+public:
+    MappedFile() : bytes(nullptr), length(0), lines(0) {
+#ifdef _WIN32
+        fileHandle = INVALID_HANDLE_VALUE;
+        mappingHandle = nullptr;
+#endif
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fungsi untuk membuka dan memetakan file; mengembalikan false jika gagal. Tanpa
+    // indexLines, indeks baris tidak dibangun (lineCount() 0) dan hanya data() yang
+    // dipakai, misalnya untuk memindai file sekali jalan.
+    bool open(const string& path, bool indexLines = true) {
+        close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            close();
+            return false;
+        }
+        length = (size_t)fileSize.QuadPart;
+        if (length > 0) {
+            mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingHandle == nullptr) {
+                close();
+                return false;
+            }
+            bytes = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            if (bytes == nullptr) {
+                close();
+                return false;
+            }
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = (size_t)info.st_size;
+        if (length > 0) {
+            void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            bytes = static_cast<const char*>(mapped);
+        }
+        ::close(fd); // Pemetaan tetap berlaku setelah descriptor ditutup
+#endif
+        if (indexLines) buildIndex();
+        return true;
+    }
+
+    // Fungsi untuk melepas pemetaan file
+    void close() {
+#ifdef _WIN32
+        if (bytes != nullptr) UnmapViewOfFile(bytes);
+        if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (bytes != nullptr) munmap(const_cast<char*>(bytes), length);
+#endif
+        bytes = nullptr;
+        length = 0;
+        lines = 0;
+        checkpoints.clear();
+    }
+
+    size_t lineCount() const { return lines; }
+    size_t size() const { return length; }
+    const char* data() const { return bytes; }
+
+    // Fungsi untuk mendapatkan offset awal sebuah baris: lompat ke checkpoint
+    // terdekat, lalu maju paling banyak LINE_STRIDE - 1 baris dengan memchr
+    size_t lineStart(size_t line) const {
+        if (line >= lines) return length;
+        size_t offset = checkpoints[line / LINE_STRIDE];
+        for (size_t i = line % LINE_STRIDE; i > 0; i--) {
+            const char* newline = static_cast<const char*>(memchr(bytes + offset, '\n', length - offset));
+            offset = (size_t)(newline - bytes) + 1;
+        }
+        return offset;
+    }
+
+    // Fungsi untuk mendapatkan nomor baris yang memuat byte ke-offset: checkpoint dicari
+    // dengan binary search, lalu paling banyak LINE_STRIDE baris dipindai
+    size_t lineOfOffset(size_t offset) const {
+        if (lines == 0) return 0;
+        if (offset >= length) return lines - 1;
+        size_t chunk = (size_t)(upper_bound(checkpoints.begin(), checkpoints.end(), offset) - checkpoints.begin()) - 1;
+        size_t line = chunk * LINE_STRIDE;
+        size_t start = checkpoints[chunk];
+        while (line + 1 < lines) {
+            const char* newline = static_cast<const char*>(memchr(bytes + start, '\n', length - start));
+            if (newline == nullptr || (size_t)(newline - bytes) >= offset) break;
+            start = (size_t)(newline - bytes) + 1;
+            line++;
+        }
+        return line;
+    }
+
+    // Fungsi untuk membaca satu baris mulai dari offset start (tanpa '\n' atau '\r\n').
+    // Jika nextStart tidak null, diisi dengan offset awal baris berikutnya.
+    string_view lineAt(size_t start, size_t* nextStart = nullptr) const {
+        if (start >= length) {
+            if (nextStart != nullptr) *nextStart = length;
+            return string_view();
+        }
+        const char* newline = static_cast<const char*>(memchr(bytes + start, '\n', length - start));
+        size_t end = (newline != nullptr) ? (size_t)(newline - bytes) : length;
+        if (nextStart != nullptr) *nextStart = (newline != nullptr) ? end + 1 : length;
+        if (end > start && bytes[end - 1] == '\r') end--;
+        return string_view(bytes + start, end - start);
+    }
+
+    // Fungsi untuk membaca satu baris yang akhirnya sudah diketahui: [start, end) memuat
+    // baris beserta akhir barisnya (kecuali baris terakhir tanpa newline), jadi '\n'
+    // tidak perlu dicari dan biayanya O(1) berapa pun panjang barisnya
+    string_view lineBetween(size_t start, size_t end) const {
+        end = min(end, length);
+        if (start >= end) return string_view();
+        if (bytes[end - 1] == '\n') end--;
+        if (end > start && bytes[end - 1] == '\r') end--;
+        return string_view(bytes + start, end - start);
+    }
+};
+
+// Versi dokumen yang tidak berubah, untuk pembaca di thread lain (lihat PersistentRope.h)
+typedef PersistentRope<MappedFile> DocumentVersions;
+typedef DocumentVersions::Snapshot DocumentSnapshot;
+
+// Struktur untuk menyimpan aksi yang dilakukan oleh pengguna. Action adalah bentuk
+// terurai yang hanya hidup sebentar, saat aksi dicatat atau di-undo/redo; di dalam
+// riwayat, aksi disimpan dalam bentuk ringkas oleh HistoryLog.
 struct Action {
     // Jenis aksi yang bisa dilakukan
     enum ActionType {
@@ -13,734 +579,4236 @@ struct Action {
         INSERT_CHAR,    // Menyisipkan karakter
         DELETE_CHAR,    // Menghapus karakter
         REPLACE_CHAR,   // Mengganti karakter
-        REPLACE_TEXT    // Mengganti teks berdasarkan pencarian
+        REPLACE_TEXT,   // Mengganti teks berdasarkan pencarian
+        REPLACE_PATTERN, // Mengganti teks yang cocok dengan pola (daftar kata atau regex)
+        GROUP            // Penanda grup: groupSize aksi di bawahnya di-undo/redo sekaligus
     } type;
 
-    int linePosition;    // Posisi baris dalam linked list (dimulai dari 0)
+    int linePosition;    // Posisi baris dalam linked list (dimulai dari 0; saat dicatat, dan
+                         // tetap disimpan di riwayat hanya untuk INSERT_LINE dan DELETE_LINE)
     int charIndex;       // Indeks karakter dalam baris (hanya untuk aksi karakter)
     string data;         // Data yang terkait dengan aksi (untuk INSERT_LINE dan DELETE_LINE)
     char oldChar;        // Karakter lama sebelum diganti (untuk REPLACE_CHAR)
     char newChar;        // Karakter baru setelah diganti (untuk REPLACE_CHAR)
+    int groupSize;       // Jumlah aksi anggota grup (untuk GROUP)
+    uint32_t anchor;     // Jangkar baris (lihat LinkedList::anchors) untuk aksi karakter; untuk
+                         // INSERT_LINE dan DELETE_LINE, jangkar yang dipasang lagi saat baris dibuat ulang
 
-    // Struktur untuk menyimpan informasi penggantian teks
+    // Struktur untuk menyimpan informasi penggantian teks. Teks lama dan teks baru
+    // selalu sama dengan searchText dan replaceWithText milik aksinya, jadi tidak
+    // disalin ulang untuk setiap penggantian.
     struct Replacement {
-        int linePos;          // Posisi baris tempat penggantian terjadi
+        uint32_t anchor;      // Jangkar baris tempat penggantian terjadi
         int charIdx;          // Indeks karakter tempat penggantian terjadi
-        string oldText;       // Teks lama sebelum penggantian
-        string newText;       // Teks baru yang menggantikan oldText
     };
 
-    vector<Replacement> replacements; // Menyimpan semua penggantian teks (untuk REPLACE_TEXT)
-    string searchText;                // Teks yang dicari (untuk REPLACE_TEXT)
-    string replaceWithText;           // Teks pengganti (untuk REPLACE_TEXT)
+    vector<Replacement> replacements; // Daftar penggantian (untuk REPLACE_TEXT dan REPLACE_PATTERN)
+    string searchText;                // Teks yang dicari, atau pola untuk REPLACE_PATTERN
+    string replaceWithText;           // Teks pengganti
+    vector<int> oldLengths;           // Panjang teks lama setiap penggantian (REPLACE_PATTERN)
+    string oldTexts;                  // Teks lama setiap penggantian, disambung (REPLACE_PATTERN)
+
+    // Konstruktor untuk aksi kosong (diisi oleh HistoryLog saat catatan dibaca)
+    Action() : type(INSERT_LINE), linePosition(-1), charIndex(-1), oldChar('\0'), newChar('\0'), groupSize(0), anchor(0) {}
 
     // Konstruktor untuk aksi INSERT_LINE dan DELETE_LINE
-    Action(ActionType type, int linePos, const string& d)
-        : type(type), linePosition(linePos), charIndex(-1), data(d), oldChar('\0'), newChar('\0'), searchText(""), replaceWithText("") {}
+    Action(ActionType type, int linePos, string_view d)
+        : type(type), linePosition(linePos), charIndex(-1), data(d), oldChar('\0'), newChar('\0'), groupSize(0), anchor(0) {}
 
     // Konstruktor untuk aksi karakter: INSERT_CHAR, DELETE_CHAR, REPLACE_CHAR
     Action(ActionType type, int linePos, int cIndex, char oldC = '\0', char newC = '\0')
-        : type(type), linePosition(linePos), charIndex(cIndex), data(""), oldChar(oldC), newChar(newC), searchText(""), replaceWithText("") {}
+        : type(type), linePosition(linePos), charIndex(cIndex), oldChar(oldC), newChar(newC), groupSize(0), anchor(0) {}
 
     // Konstruktor untuk aksi REPLACE_TEXT
-    Action(ActionType type, const string& search, const string& replace, const vector<Replacement>& reps)
-        : type(type), linePosition(-1), charIndex(-1), data(""), oldChar('\0'), newChar('\0'), searchText(search), replaceWithText(replace), replacements(reps) {}
-};
+    Action(ActionType type, string_view search, string_view replace, const vector<Replacement>& reps)
+        : type(type), linePosition(-1), charIndex(-1), oldChar('\0'), newChar('\0'), groupSize(0), anchor(0),
+          replacements(reps), searchText(search), replaceWithText(replace) {}
 
-// Kelas Node merepresentasikan satu baris teks dalam editor
-class Node {
-public:
-    string data; // Teks yang disimpan dalam baris ini
-    Node* prev;  // Pointer ke node (baris) sebelumnya
-    Node* next;  // Pointer ke node (baris) berikutnya
+    // Konstruktor untuk aksi REPLACE_PATTERN. Teks yang cocok berbeda-beda untuk setiap
+    // penggantian, jadi panjang dan isi teks lamanya ikut disimpan.
+    Action(string_view pattern, string_view replace, const vector<Replacement>& reps,
+           const vector<int>& oldLengths, string_view oldTexts)
+        : type(REPLACE_PATTERN), linePosition(-1), charIndex(-1), oldChar('\0'), newChar('\0'), groupSize(0), anchor(0),
+          replacements(reps), searchText(pattern), replaceWithText(replace), oldLengths(oldLengths), oldTexts(oldTexts) {}
 
-    // Konstruktor untuk Node
-    Node(string data) {
-        this->data = data;
-        this->prev = nullptr;
-        this->next = nullptr;
+    // Konstruktor untuk penanda GROUP yang mencakup size aksi sebelumnya
+    Action(ActionType type, int size)
+        : type(type), linePosition(-1), charIndex(-1), oldChar('\0'), newChar('\0'), groupSize(size), anchor(0) {}
+
+    // Fungsi untuk memeriksa apakah catatan riwayat jenis aksi ini menyimpan nomor baris
+    // (linePosition). Aksi lain menemukan barisnya lewat jangkar.
+    static bool hasLine(ActionType type) {
+        return type == INSERT_LINE || type == DELETE_LINE;
+    }
+
+    // Fungsi untuk mendapatkan jumlah penggantian yang tersimpan
+    size_t replacementCount() const {
+        return replacements.size();
     }
 };
 
-// Kelas LinkedList mengelola daftar baris teks dan operasi terkait
-class LinkedList {
+// Kelas HistoryLog menyimpan tumpukan aksi (undoStack atau redoStack) sebagai deretan
+// byte. Setiap aksi menjadi satu catatan: jenis aksi dalam satu byte, lalu angka-angka
+// dalam varint. Nomor baris (hanya INSERT_LINE dan DELETE_LINE) disimpan sebagai selisih
+// (zigzag) dari baris catatan sebelumnya, sehingga aksi yang berdekatan cukup satu byte
+// per nomor baris. Aksi lain menyimpan jangkar baris; jangkar setiap penggantian disimpan
+// sebagai selisih dari penggantian sebelumnya dalam catatan yang sama. Kata kunci,
+// teks pengganti, dan teks lama pola dirujuk lewat id di StringPool. Panjang catatan
+// ditulis lagi di ujungnya (varint terbalik) agar catatan terakhir bisa dibaca mundur.
+//
+// Jika batas byte diatur, catatan tertua dibuang dari depan setiap kali push membuat
+// pemakaian (catatan + teks string yang dirujuknya) melebihi batas. StringPool bisa
+// dipakai bersama oleh banyak riwayat, jadi yang dihitung hanya string milik riwayat
+// ini. Ruang kosong di depan dirapatkan sekaligus setelah lebih besar dari separuh
+// buffer.
+//
+// Penanda GROUP mencakup groupSize catatan tepat di bawahnya, jadi grup dibuang utuh
+// bersama penandanya sebagai satu unit; unit terbaru selalu disisakan walaupun lebih
+// besar dari batas. Selama sebuah grup disusun (transaksi atau edit yang digabung),
+// batas ditahan lewat holdBudget agar anggotanya tidak terbuang sebelum penandanya masuk.
+//
+// Riwayat yang sedang tidak dipakai bisa dipindah (spill) ke file sementara untuk
+// melepas memorinya; catatan dibaca kembali secara otomatis sebelum dipakai lagi.
+class HistoryLog {
 private:
-    Node* head; // Pointer ke baris pertama dalam linked list
-    Node* tail; // Pointer ke baris terakhir dalam linked list
-
-    // Stack untuk menyimpan aksi yang bisa di-undo dan di-redo
-    stack<Action> undoStack; // Menyimpan aksi untuk undo
-    stack<Action> redoStack; // Menyimpan aksi untuk redo
+    static const size_t COMPACT_MINIMUM = 4096; // Ruang kosong minimal sebelum dirapatkan
 
-    // Untuk navigasi dan penyorotan (highlighting)
-    Node* currentNode;        // Baris (node) yang sedang di-highlight
-    int currentCharIndex;     // Indeks karakter yang sedang di-highlight dalam currentNode
+    StringPool& strings;         // Pool string bersama (undoStack dan redoStack)
+    size_t stringBytes;          // Byte teks string di pool yang dirujuk catatan riwayat ini
+    vector<unsigned char> bytes; // Catatan berurutan; yang hidup mulai dari head
+    size_t head;                 // Offset catatan tertua
+    size_t records;              // Jumlah catatan
+    long long firstBase;         // Baris acuan sebelum catatan tertua
+    long long lastLine;          // Baris acuan sesudah catatan terbaru
+    size_t budget;               // Batas byte (0 = tanpa batas)
+    size_t evicted;              // Jumlah catatan tertua yang sudah dibuang karena batas
+    bool budgetHeld;             // Batas ditunda selama sebuah grup sedang disusun
+    // Penanda GROUP yang hidup: (nomor urut penanda, jumlah anggota). Nomor urut dihitung
+    // sejak catatan pertama, termasuk yang sudah dibuang (evicted + posisi dari head).
+    vector<pair<size_t, size_t>> groups;
+    FILE* spillFile;             // File sementara berisi catatan (nullptr = catatan di memori)
+    size_t spilledBytes;         // Panjang catatan di spillFile
 
-    // Fungsi untuk mendapatkan posisi baris saat ini dalam linked list
-    int getCurrentLinePosition() {
-        int pos = 0;
-        Node* temp = head;
-        while (temp != nullptr && temp != currentNode) {
-            temp = temp->next;
-            pos++;
+    void putVarint(unsigned long long value) {
+        while (value >= 0x80) {
+            bytes.push_back((unsigned char)(value | 0x80));
+            value >>= 7;
         }
-        return (temp == currentNode) ? pos : -1;
+        bytes.push_back((unsigned char)value);
     }
 
-public:
-    // Konstruktor untuk LinkedList
-    LinkedList() {
-        head = nullptr;
-        tail = nullptr;
-        currentNode = nullptr;
-        currentCharIndex = 0;
+    static unsigned long long getVarint(const unsigned char*& p) {
+        unsigned long long value = 0;
+        int shift = 0;
+        while (*p & 0x80) {
+            value |= (unsigned long long)(*p++ & 0x7f) << shift;
+            shift += 7;
+        }
+        value |= (unsigned long long)(*p++) << shift;
+        return value;
     }
 
-    // Destruktor untuk membersihkan memori yang dialokasikan
-    ~LinkedList() {
-        Node* current = head;
-        while (current != nullptr) {
-            Node* next = current->next;
-            delete current; // Menghapus node saat ini
-            current = next; // Pindah ke node berikutnya
+    static size_t varintSize(unsigned long long value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
         }
+        return size;
     }
 
-    // Fungsi untuk menyisipkan baris baru pada posisi tertentu
-    void insertLine(int position, const string& data, bool record = true) {
-        Node* newNode = new Node(data); // Membuat node baru dengan data yang diberikan
+    static unsigned long long zigzag(long long value) {
+        return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+    }
 
-        // Jika linked list kosong, set newNode sebagai head dan tail
-        if (head == nullptr) {
-            head = tail = newNode;
-            currentNode = head; // Set currentNode ke baris pertama
-            if (record) {
-                // Mencatat aksi INSERT_LINE ke undoStack
-                undoStack.push(Action(Action::INSERT_LINE, 0, data));
-                // Kosongkan redoStack karena aksi baru dilakukan
-                while (!redoStack.empty()) redoStack.pop();
-            }
-            return;
-        }
+    static long long unzigzag(unsigned long long value) {
+        return (long long)(value >> 1) ^ -(long long)(value & 1);
+    }
+
+    // Fungsi untuk mendapatkan id string di pool sambil menghitungnya sebagai milik riwayat ini
+    unsigned int intern(string_view text) {
+        stringBytes += text.size();
+        return strings.intern(text);
+    }
+
+    // Fungsi untuk melepas referensi riwayat ini ke string id
+    void release(unsigned int id) {
+        stringBytes -= strings.view(id).size();
+        strings.release(id);
+    }
+
+    // Fungsi untuk menambahkan isi catatan sebuah aksi ke ujung buffer; line adalah
+    // baris acuan dan diperbarui menjadi baris acuan sesudah catatan ini
+    void encode(const Action& action, long long& line) {
+        bytes.push_back((unsigned char)action.type);
+        switch (action.type) {
+            case Action::INSERT_LINE:
+            case Action::DELETE_LINE:
+                putVarint(zigzag(action.linePosition - line));
+                line = action.linePosition;
+                putVarint(action.data.size());
+                bytes.insert(bytes.end(), action.data.begin(), action.data.end());
+                putVarint(action.anchor);
+                break;
+
+            case Action::INSERT_CHAR:
+            case Action::DELETE_CHAR:
+            case Action::REPLACE_CHAR:
+                putVarint(action.anchor);
+                putVarint(action.charIndex);
+                bytes.push_back((unsigned char)action.oldChar);
+                if (action.type != Action::DELETE_CHAR) bytes.push_back((unsigned char)action.newChar);
+                break;
 
-        // Jika menyisipkan di posisi pertama (posisi 0)
-        if (position == 0) {
-            newNode->next = head;
-            head->prev = newNode;
-            head = newNode; // Update head ke node baru
-            if (record) {
-                undoStack.push(Action(Action::INSERT_LINE, 0, data));
-                while (!redoStack.empty()) redoStack.pop();
+            case Action::REPLACE_TEXT:
+            case Action::REPLACE_PATTERN: {
+                putVarint(intern(action.searchText));
+                putVarint(intern(action.replaceWithText));
+                putVarint(action.replacements.size());
+                size_t oldOffset = 0;
+                long long anchor = 0; // Jangkar acuan; jangkar baris yang berurutan biasanya berurutan juga
+                long long column = 0; // Kolom acuan, kembali ke 0 setiap pindah baris
+                for (size_t i = 0; i < action.replacements.size(); i++) {
+                    const Action::Replacement& rep = action.replacements[i];
+                    if (rep.anchor != anchor) column = 0;
+                    putVarint(zigzag(rep.anchor - anchor));
+                    putVarint(zigzag(rep.charIdx - column));
+                    anchor = rep.anchor;
+                    column = rep.charIdx;
+                    if (action.type == Action::REPLACE_PATTERN) {
+                        putVarint(intern(string_view(action.oldTexts).substr(oldOffset, action.oldLengths[i])));
+                        oldOffset += action.oldLengths[i];
+                    }
+                }
+                break;
             }
-            return;
+
+            case Action::GROUP:
+                putVarint(action.groupSize);
+                break;
         }
+    }
 
-        // Mencari posisi di mana baris baru akan disisipkan
-        Node* current = head;
-        int index = 0;
-        while (current != nullptr && index < position - 1) {
-            current = current->next;
-            index++;
+    // Fungsi untuk membaca satu catatan mulai dari p (kebalikan dari encode). Isi catatan
+    // disalin ke action jika tidak null; jika releaseStrings, referensi string-nya dilepas.
+    const unsigned char* decode(const unsigned char* p, long long& line, Action* action, bool releaseStrings) {
+        Action::ActionType type = (Action::ActionType)*p++;
+        if (action != nullptr) {
+            *action = Action();
+            action->type = type;
         }
+        auto takeString = [&](string& out) {
+            unsigned int id = (unsigned int)getVarint(p);
+            if (action != nullptr) out.assign(strings.view(id));
+            if (releaseStrings) release(id);
+        };
 
-        // Jika posisi melebihi jumlah baris, sisipkan di akhir
-        if (current == tail) {
-            tail->next = newNode;
-            newNode->prev = tail;
-            tail = newNode; // Update tail ke node baru
-            if (record) {
-                undoStack.push(Action(Action::INSERT_LINE, index + 1, data));
-                while (!redoStack.empty()) redoStack.pop();
+        switch (type) {
+            case Action::INSERT_LINE:
+            case Action::DELETE_LINE: {
+                line += unzigzag(getVarint(p));
+                size_t length = (size_t)getVarint(p);
+                if (action != nullptr) {
+                    action->linePosition = (int)line;
+                    action->data.assign(reinterpret_cast<const char*>(p), length);
+                }
+                p += length;
+                uint32_t anchor = (uint32_t)getVarint(p);
+                if (action != nullptr) action->anchor = anchor;
+                break;
             }
-        }
-        else if (current != nullptr) {
-            // Menyisipkan di tengah-tengah linked list
-            Node* nextNode = current->next;
-            newNode->next = nextNode;
-            newNode->prev = current;
-            current->next = newNode;
-            if (nextNode != nullptr) {
-                nextNode->prev = newNode;
+
+            case Action::INSERT_CHAR:
+            case Action::DELETE_CHAR:
+            case Action::REPLACE_CHAR: {
+                uint32_t anchor = (uint32_t)getVarint(p);
+                int charIndex = (int)getVarint(p);
+                char oldChar = (char)*p++;
+                char newChar = (type != Action::DELETE_CHAR) ? (char)*p++ : '\0';
+                if (action != nullptr) {
+                    action->anchor = anchor;
+                    action->charIndex = charIndex;
+                    action->oldChar = oldChar;
+                    action->newChar = newChar;
+                }
+                break;
             }
-            if (record) {
-                undoStack.push(Action(Action::INSERT_LINE, index + 1, data));
-                while (!redoStack.empty()) redoStack.pop();
+
+            case Action::REPLACE_TEXT:
+            case Action::REPLACE_PATTERN: {
+                string unused;
+                takeString(action != nullptr ? action->searchText : unused);
+                takeString(action != nullptr ? action->replaceWithText : unused);
+                size_t count = (size_t)getVarint(p);
+                long long anchor = 0;
+                long long column = 0;
+                for (size_t i = 0; i < count; i++) {
+                    long long delta = unzigzag(getVarint(p));
+                    if (delta != 0) column = 0;
+                    anchor += delta;
+                    column += unzigzag(getVarint(p));
+                    if (action != nullptr) action->replacements.push_back(Action::Replacement{ (uint32_t)anchor, (int)column });
+                    if (type == Action::REPLACE_PATTERN) {
+                        unsigned int id = (unsigned int)getVarint(p);
+                        if (action != nullptr) {
+                            string_view oldText = strings.view(id);
+                            action->oldLengths.push_back((int)oldText.size());
+                            action->oldTexts.append(oldText.data(), oldText.size());
+                        }
+                        if (releaseStrings) release(id);
+                    }
+                }
+                break;
             }
-        }
-        else {
-            // Jika posisi tidak valid, sisipkan di akhir
-            tail->next = newNode;
-            newNode->prev = tail;
-            tail = newNode;
-            if (record) {
-                undoStack.push(Action(Action::INSERT_LINE, index + 1, data));
-                while (!redoStack.empty()) redoStack.pop();
+
+            case Action::GROUP: {
+                int groupSize = (int)getVarint(p);
+                if (action != nullptr) action->groupSize = groupSize;
+                break;
             }
         }
+        return p;
     }
 
-    // Fungsi untuk menghapus baris pada posisi tertentu
-    void deleteLine(int position, bool record = true) {
-        if (head == nullptr) return; // Tidak ada baris untuk dihapus
-
-        Node* toDelete = head;
-        int index = 0;
-        while (toDelete != nullptr && index < position) {
-            toDelete = toDelete->next;
-            index++;
-        }
-
-        if (toDelete == nullptr) return; // Posisi tidak valid
+    // Fungsi untuk mendapatkan awal catatan terbaru dengan membaca panjangnya dari ujung
+    size_t lastRecordStart(size_t& suffixLength) const {
+        size_t end = bytes.size();
+        unsigned long long length = 0;
+        int shift = 0;
+        suffixLength = 0;
+        unsigned char byte;
+        do {
+            byte = bytes[end - 1 - suffixLength++];
+            length |= (unsigned long long)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return end - suffixLength - (size_t)length;
+    }
 
-        string data = toDelete->data; // Menyimpan data baris yang akan dihapus
+    // Fungsi untuk membaca catatan terbaru; base diisi dengan baris acuan sebelumnya
+    void readLast(Action* action, bool releaseStrings, size_t& start, long long& base) {
+        size_t suffixLength;
+        start = lastRecordStart(suffixLength);
+        // Catatan hanya menyimpan selisih baris, jadi baca dulu dari acuan 0 lalu geser
+        long long end = 0;
+        decode(bytes.data() + start, end, action, releaseStrings);
+        base = lastLine - end;
+        if (action != nullptr && Action::hasLine(action->type)) action->linePosition += (int)base;
+    }
 
-        // Menghapus node dari linked list
-        if (toDelete == head) {
-            head = toDelete->next;
-            if (head != nullptr) head->prev = nullptr;
+    // Fungsi untuk membuang catatan tertua
+    void evictOldest() {
+        const unsigned char* p = decode(bytes.data() + head, firstBase, nullptr, true);
+        size_t payload = p - (bytes.data() + head);
+        head += payload + varintSize(payload); // Termasuk panjang di ujung catatan
+        records--;
+        evicted++;
+        if (records == 0) {
+            bytes.clear();
+            head = 0;
         }
-        else if (toDelete == tail) {
-            tail = toDelete->prev;
-            if (tail != nullptr) tail->next = nullptr;
-        }
-        else {
-            Node* prevNode = toDelete->prev;
-            Node* nextNode = toDelete->next;
-            if (prevNode != nullptr) prevNode->next = nextNode;
-            if (nextNode != nullptr) nextNode->prev = prevNode;
+        else if (head >= COMPACT_MINIMUM && head * 2 >= bytes.size()) {
+            bytes.erase(bytes.begin(), bytes.begin() + head);
+            head = 0;
         }
+    }
 
-        // Jika node yang dihapus adalah currentNode, perbarui currentNode
-        if (toDelete == currentNode) {
-            if (toDelete->next != nullptr) {
-                currentNode = toDelete->next;
-                currentCharIndex = 0;
-            }
-            else if (toDelete->prev != nullptr) {
-                currentNode = toDelete->prev;
-                currentCharIndex = currentNode->data.length() - 1;
-            }
-            else {
-                currentNode = nullptr;
-                currentCharIndex = 0;
-            }
+    // Fungsi untuk mendapatkan jumlah catatan unit tertua: satu grup beserta penandanya,
+    // atau satu catatan lepas
+    size_t oldestUnit() const {
+        if (!groups.empty() && groups.front().first - groups.front().second <= evicted) {
+            return groups.front().first - evicted + 1;
         }
+        return 1;
+    }
 
-        delete toDelete; // Menghapus node dari memori
-
-        if (record) {
-            // Mencatat aksi DELETE_LINE ke undoStack
-            undoStack.push(Action(Action::DELETE_LINE, position, data));
-            // Kosongkan redoStack karena aksi baru dilakukan
-            while (!redoStack.empty()) redoStack.pop();
+    // Fungsi untuk membuang unit tertua selama pemakaian melebihi batas; unit terbaru
+    // selalu disisakan agar aksi terakhir tetap bisa di-undo
+    void enforceBudget() {
+        if (budget == 0 || budgetHeld) return;
+        while (bytesUsed() + stringBytes > budget) {
+            size_t unit = oldestUnit();
+            if (unit >= records) break;
+            bool group = unit > 1 || (!groups.empty() && groups.front().first == evicted);
+            for (size_t i = 0; i < unit; i++) evictOldest();
+            if (group) groups.erase(groups.begin());
         }
     }
 
-    // Fungsi untuk menghapus karakter pada posisi saat ini
-    void deleteCurrentChar(bool record = true) {
-        if (currentNode == nullptr) {
-            cout << "Tidak ada baris tersedia." << endl;
-            return;
+    // Fungsi untuk membaca kembali catatan yang di-spill ke memori. Jika file sementara
+    // tidak bisa dibaca, catatan tidak bisa dipulihkan dan riwayat dikosongkan (string
+    // yang dirujuknya tetap tertahan di pool, tetapi tidak lagi dihitung sebagai miliknya).
+    void load() {
+        if (spillFile == nullptr) return;
+        bytes.resize(spilledBytes);
+        rewind(spillFile);
+        bool ok = fread(bytes.data(), 1, spilledBytes, spillFile) == spilledBytes;
+        fclose(spillFile);
+        spillFile = nullptr;
+        if (!ok) {
+            bytes.clear();
+            head = 0;
+            records = 0;
+            firstBase = lastLine = 0;
+            stringBytes = 0;
+            groups.clear();
         }
+    }
 
-        if (currentCharIndex < 0 || currentCharIndex >= currentNode->data.length()) {
-            cout << "Indeks karakter saat ini di luar batas." << endl;
-            return;
-        }
+public:
+    explicit HistoryLog(StringPool& strings)
+        : strings(strings), stringBytes(0), head(0), records(0), firstBase(0), lastLine(0), budget(0), evicted(0),
+          budgetHeld(false), spillFile(nullptr), spilledBytes(0) {}
+
+    ~HistoryLog() {
+        if (spillFile != nullptr) fclose(spillFile);
+    }
 
-        char deletedChar = currentNode->data[currentCharIndex]; // Menyimpan karakter yang akan dihapus
-        string before = currentNode->data; // Menyimpan keadaan sebelum perubahan
+    HistoryLog(const HistoryLog&) = delete;
+    HistoryLog& operator=(const HistoryLog&) = delete;
 
-        // Menghapus karakter dari baris
-        currentNode->data.erase(currentCharIndex, 1);
-        cout << "Menghapus karakter '" << deletedChar << "' pada posisi " << currentCharIndex << "." << endl;
+    bool empty() const { return records == 0; }
+    size_t size() const { return records; }
+    size_t bytesUsed() const { return bytes.size() - head; }
+    size_t bytesReserved() const { return bytes.capacity(); }
+    size_t stringBytesUsed() const { return stringBytes; }
+    size_t byteBudget() const { return budget; }
+    size_t evictedCount() const { return evicted; }
+    bool spilled() const { return spillFile != nullptr; }
+    size_t bytesSpilled() const { return spillFile != nullptr ? spilledBytes : 0; }
 
-        if (record) {
-            int linePos = getCurrentLinePosition(); // Mendapatkan posisi baris saat ini
-            if (linePos != -1) {
-                // Mencatat aksi DELETE_CHAR ke undoStack
-                undoStack.push(Action(Action::DELETE_CHAR, linePos, currentCharIndex, deletedChar, '\0'));
-                // Kosongkan redoStack karena aksi baru dilakukan
-                while (!redoStack.empty()) redoStack.pop();
-            }
-        }
+    // Fungsi untuk mengatur batas byte (0 = tanpa batas) dan langsung menerapkannya
+    void setBudget(size_t bytesLimit) {
+        load();
+        budget = bytesLimit;
+        enforceBudget();
+    }
 
-        // Menyesuaikan indeks karakter jika diperlukan setelah penghapusan
-        if (currentCharIndex >= currentNode->data.length()) {
-            if (currentCharIndex > 0) {
-                currentCharIndex--;
-            }
-        }
+    // Fungsi untuk menunda batas selama sebuah grup disusun
+    void holdBudget() {
+        budgetHeld = true;
+    }
 
-        display(); // Menampilkan teks setelah penghapusan
+    // Fungsi untuk menerapkan lagi batas setelah penanda grup masuk
+    void releaseBudget() {
+        load();
+        budgetHeld = false;
+        enforceBudget();
     }
 
-    // Fungsi untuk mengganti karakter pada posisi saat ini
-    void replaceCurrentChar(char newChar, bool record = true) {
-        if (currentNode == nullptr) {
-            cout << "Tidak ada baris tersedia." << endl;
-            return;
+    // Fungsi untuk merapatkan buffer: ruang kosong di depan dibuang dan kapasitas yang
+    // tidak terpakai dikembalikan. Mengembalikan jumlah byte yang dilepas.
+    size_t compact() {
+        size_t before = bytes.capacity();
+        if (head > 0) {
+            bytes.erase(bytes.begin(), bytes.begin() + head);
+            head = 0;
         }
+        bytes.shrink_to_fit();
+        return before - bytes.capacity();
+    }
 
-        if (currentCharIndex < 0 || currentCharIndex >= currentNode->data.length()) {
-            cout << "Indeks karakter saat ini di luar batas." << endl;
-            return;
+    // Fungsi untuk memindahkan catatan ke file sementara (dihapus otomatis saat ditutup)
+    // dan melepas memorinya. Mengembalikan jumlah byte yang dilepas (0 jika kosong,
+    // sudah di-spill, atau file sementara gagal ditulis).
+    size_t spill() {
+        if (spillFile != nullptr || records == 0) return 0;
+        compact();
+        FILE* file = tmpfile();
+        if (file == nullptr) return 0;
+        if (fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size() || fflush(file) != 0) {
+            fclose(file);
+            return 0;
         }
+        spillFile = file;
+        spilledBytes = bytes.size();
+        vector<unsigned char>().swap(bytes);
+        return spilledBytes;
+    }
 
-        char oldChar = currentNode->data[currentCharIndex]; // Menyimpan karakter lama
-        currentNode->data[currentCharIndex] = newChar;      // Mengganti karakter dengan yang baru
-        cout << "Mengganti karakter '" << oldChar << "' dengan '" << newChar << "' pada posisi " << currentCharIndex << "." << endl;
-
-        if (record) {
-            int linePos = getCurrentLinePosition(); // Mendapatkan posisi baris saat ini
-            if (linePos != -1) {
-                // Mencatat aksi REPLACE_CHAR ke undoStack
-                undoStack.push(Action(Action::REPLACE_CHAR, linePos, currentCharIndex, oldChar, newChar));
-                // Kosongkan redoStack karena aksi baru dilakukan
-                while (!redoStack.empty()) redoStack.pop();
-            }
+    // Fungsi untuk menambahkan aksi sebagai catatan terbaru
+    void push(const Action& action) {
+        load();
+        size_t start = bytes.size();
+        if (records == 0) firstBase = lastLine;
+        if (action.type == Action::GROUP) {
+            // Penanda tidak boleh mencakup lebih banyak catatan daripada yang masih ada
+            Action marker(Action::GROUP, (int)min((size_t)max(action.groupSize, 0), records));
+            groups.push_back({ evicted + records, (size_t)marker.groupSize });
+            encode(marker, lastLine);
+        }
+        else {
+            encode(action, lastLine);
         }
+        unsigned long long length = bytes.size() - start;
+        size_t suffixStart = bytes.size();
+        putVarint(length);
+        reverse(bytes.begin() + suffixStart, bytes.end());
+        records++;
+        enforceBudget();
+    }
 
-        display(); // Menampilkan teks setelah penggantian
+    // Fungsi untuk membaca aksi terbaru tanpa mengeluarkannya
+    Action top() {
+        load();
+        Action action;
+        size_t start;
+        long long base;
+        readLast(&action, false, start, base);
+        return action;
     }
 
-    // Fungsi untuk mengganti teks berdasarkan pencarian sederhana
-    void replaceText(const string& search, const string& replace, bool record = true) {
-        if (search.empty()) {
-            cout << "Kata kunci pencarian tidak boleh kosong." << endl;
-            return;
+    // Fungsi untuk mengeluarkan aksi terbaru
+    void pop() {
+        load();
+        size_t start;
+        long long base;
+        readLast(nullptr, true, start, base);
+        bytes.resize(start);
+        lastLine = base;
+        if (!groups.empty() && groups.back().first == evicted + records - 1) groups.pop_back();
+        records--;
+        if (records == 0) {
+            bytes.clear();
+            head = 0;
         }
+    }
 
-        vector<Action::Replacement> allReplacements; // Menyimpan semua penggantian yang dilakukan
+    // Fungsi untuk mengosongkan semua catatan beserta referensi string-nya
+    void clear() {
+        load();
+        if (records == 0) return;
+        const unsigned char* p = bytes.data() + head;
+        for (size_t i = 0; i < records; i++) {
+            const unsigned char* start = p;
+            p = decode(p, firstBase, nullptr, true);
+            p += varintSize(p - start); // Lewati panjang di ujung catatan
+        }
+        bytes.clear();
+        head = 0;
+        records = 0;
+        firstBase = lastLine = 0;
+        groups.clear();
+    }
+};
 
-        Node* current = head;
-        int linePos = 0;
+// Kelas Node merepresentasikan satu baris teks dalam editor. Untuk file yang dibuka
+// lewat pemetaan memori, sebuah node juga bisa mewakili "run": sejumlah baris file
+// yang berurutan dan belum pernah disentuh. Teks baris run dibaca langsung dari file;
+// baru disalin ke data ketika baris itu diedit.
+//
+// Urutan field disusun agar tidak ada padding (sizeof(Node) == 128, satu kelas ukuran
+// Arena) dan field yang dibaca saat pemindaian berurutan (next, runCount, data) berada
+// di awal objek, dalam cache line yang sama.
+class Node {
+public:
+    Node* next;          // Pointer ke node (baris) berikutnya
+    int runCount;        // Jumlah baris file yang diwakili (0 = teks ada di data)
+    uint32_t indexKey;   // Kunci baris di indeks trigram (hanya berlaku jika runCount == 0)
+    LineText data;       // Teks baris; teks pendek berada langsung di dalam node
+    Node* prev;          // Pointer ke node (baris) sebelumnya
 
-        // Iterasi melalui semua baris dalam linked list
-        while (current != nullptr) {
-            size_t pos = 0;
-            // Cari semua kemunculan kata kunci dalam baris
-            while ((pos = current->data.find(search, pos)) != string::npos) {
-                // Simpan informasi penggantian sebelum dilakukan
-                Action::Replacement rep;
-                rep.linePos = linePos;
-                rep.charIdx = pos;
-                rep.oldText = search;
-                rep.newText = replace; // Menyimpan teks pengganti
-                allReplacements.push_back(rep);
+    // Sumber teks dari file yang dipetakan (hanya berlaku jika runCount > 0). Baris yang
+    // teksnya sudah di data tidak memakai sourceLine, jadi tempatnya dipakai jangkar.
+    union {
+        size_t sourceLine; // Nomor baris pertama run di dalam file
+        size_t anchor;     // Jangkar riwayat undo/redo baris ini (runCount == 0; 0 = belum ada)
+    };
+    size_t sourceOffset; // Offset byte baris pertama run di dalam file
+    size_t runBytes;     // Panjang byte run di file (termasuk newline; hanya jika runCount > 0)
 
-                // Ganti kata kunci dengan teks pengganti
-                current->data.replace(pos, search.length(), replace);
-                cout << "Mengganti \"" << search << "\" dengan \"" << replace << "\" di baris " << linePos + 1 << ", posisi " << pos + 1 << "." << endl;
+    // Bagian rope: setiap node juga menjadi simpul pohon treap implisit
+    Node* left;            // Anak kiri (baris-baris sebelum node ini dalam subtree)
+    Node* right;           // Anak kanan (baris-baris sesudah node ini dalam subtree)
+    Node* parent;          // Induk dalam treap (nullptr untuk akar), untuk menghitung posisi node
+    unsigned int priority; // Prioritas heap treap (acak) agar pohon tetap seimbang
+    int size;              // Jumlah baris dalam subtree yang berakar di node ini
+    size_t bytes;          // Jumlah byte subtree dalam bentuk tersimpan (setiap baris + newline)
 
-                pos += replace.length(); // Pindah posisi untuk pencarian berikutnya
-            }
-            current = current->next;
-            linePos++;
+    // Konstruktor untuk Node; teks disalin langsung ke dalam node atau ke memori Arena
+    Node(string_view data, Arena* arena) : data(data, arena) {
+        this->prev = nullptr;
+        this->next = nullptr;
+        this->sourceLine = 0;
+        this->sourceOffset = 0;
+        this->runCount = 0;
+        this->runBytes = 0;
+        this->indexKey = 0;
+        this->left = nullptr;
+        this->right = nullptr;
+        this->parent = nullptr;
+        this->priority = 0;
+        this->size = 1;
+        this->bytes = this->data.size() + 1;
+    }
+
+    // Fungsi untuk mendapatkan jumlah baris yang diwakili node ini
+    int weight() const {
+        return runCount > 0 ? runCount : 1;
+    }
+
+    // Fungsi untuk mendapatkan jumlah byte baris-baris node ini saat disimpan. Baris run
+    // dihitung apa adanya dari file (termasuk '\r\n'), baris lain ditambah satu '\n'.
+    size_t ownBytes() const {
+        return runCount > 0 ? runBytes : data.size() + 1;
+    }
+};
+
+// Kelas LinkedList mengelola daftar baris teks dan operasi terkait
+class LinkedList {
+private:
+    static const size_t DEFAULT_HISTORY_BUDGET = 64 * 1024 * 1024; // Batas awal memori riwayat undo
+
+    // Operasi yang diukur profiler. Undo dan redo per jenis aksi memakai
+    // PROFILE_UNDO_ACTION + Action::ActionType (begitu juga redo).
+    enum ProfiledOperation {
+        PROFILE_OPEN_FILE, PROFILE_SAVE_SNAPSHOT, PROFILE_INSERT_LINE, PROFILE_DELETE_LINE, PROFILE_NODE_AT,
+        PROFILE_DELETE_CHAR, PROFILE_REPLACE_CHAR, PROFILE_REPLACE_TEXT, PROFILE_REPLACE_PARALLEL,
+        PROFILE_REPLACE_PATTERN, PROFILE_SEARCH, PROFILE_BUILD_INDEX, PROFILE_TEXT_STATS, PROFILE_COLUMN_INDEX,
+        PROFILE_NEXT_LINE, PROFILE_PREV_LINE, PROFILE_NEXT_CHAR, PROFILE_PREV_CHAR, PROFILE_JUMP,
+        PROFILE_DISPLAY, PROFILE_DISPLAY_ALL, PROFILE_UNDO, PROFILE_REDO,
+        PROFILE_UNDO_ACTION, PROFILE_REDO_ACTION = PROFILE_UNDO_ACTION + Action::GROUP + 1,
+        PROFILE_COUNT = PROFILE_REDO_ACTION + Action::GROUP + 1
+    };
+    static constexpr const char* PROFILE_NAMES[PROFILE_COUNT] = {
+        "openFile", "saveSnapshot", "insertLine", "deleteLine", "nodeAt",
+        "deleteCurrentChar", "replaceCurrentChar", "replaceText", "replaceTextParallel",
+        "replacePattern", "search", "buildSearchIndex", "textStats", "columnIndex",
+        "moveToNextLine", "moveToPrevLine", "moveToNextChar", "moveToPrevChar", "jump",
+        "display", "displayAll", "undo", "redo",
+        "undo/INSERT_LINE", "undo/DELETE_LINE", "undo/INSERT_CHAR", "undo/DELETE_CHAR",
+        "undo/REPLACE_CHAR", "undo/REPLACE_TEXT", "undo/REPLACE_PATTERN", "undo/GROUP",
+        "redo/INSERT_LINE", "redo/DELETE_LINE", "redo/INSERT_CHAR", "redo/DELETE_CHAR",
+        "redo/REPLACE_CHAR", "redo/REPLACE_TEXT", "redo/REPLACE_PATTERN", "redo/GROUP"
+    };
+
+    Arena arena; // Memori untuk node dan teks baris (Node dan LineText)
+
+    Node* head; // Pointer ke baris pertama dalam linked list
+    Node* tail; // Pointer ke baris terakhir dalam linked list
+
+    // Stack untuk menyimpan aksi yang bisa di-undo dan di-redo, dalam bentuk ringkas
+    shared_ptr<StringPool> historyStrings; // String berulang milik kedua stack (bisa dibagi antar-buffer)
+    HistoryLog undoStack;      // Menyimpan aksi untuk undo (dibatasi historyBudget)
+    HistoryLog redoStack;      // Menyimpan aksi untuk redo
+
+    // Grup undo: transaksi eksplisit dan penggabungan edit karakter berturut-turut
+    int transactionDepth;              // Kedalaman beginTransaction yang belum di-commit
+    int transactionActions;            // Jumlah aksi yang dicatat di dalam transaksi terluar
+    int coalesceCount;                 // Jumlah edit karakter dalam grup berjalan (0 = tidak ada)
+    int coalesceLine;                  // Baris edit karakter terakhir yang dicatat
+    Action::ActionType coalesceType;   // Jenis edit karakter terakhir yang dicatat
+
+    // Untuk navigasi dan penyorotan (highlighting)
+    Node* currentNode;        // Baris (node) yang sedang di-highlight
+    int currentCharIndex;     // Indeks karakter yang sedang di-highlight dalam currentNode
+
+    // Rope: treap implisit di atas node yang sama dengan linked list. Kunci setiap
+    // node adalah posisinya (jumlah baris di subtree kiri), sehingga mencari,
+    // menyisipkan, dan menghapus baris ke-k cukup O(log n) tanpa berjalan dari head.
+    // Pointer prev/next tetap dipertahankan untuk navigasi dan penelusuran berurutan.
+    Node* root;               // Akar treap
+    unsigned int seed;        // State generator prioritas acak (xorshift32)
+
+    shared_ptr<MappedFile> source; // File yang sedang dibuka (sumber teks node run)
+    unique_ptr<ThreadPool> workers; // Pool thread untuk operasi paralel (dibuat saat pertama dipakai)
+    unique_ptr<TrigramIndex> index; // Indeks trigram pencarian (nullptr = nonaktif)
+    Renderer renderer;              // Penampil viewport di sekitar currentNode
+    bool rendering;                 // false = display() tidak menampilkan apa pun (mode batch)
+    Profiler profiler;              // Statistik per operasi (nonaktif secara bawaan)
+    BackgroundSaver saver;          // Penyimpanan file di thread terpisah
+    string documentPath;            // Path file yang terakhir dibuka atau disimpan
+
+    // Salinan persisten struktur baris untuk snapshot O(1). Dibangun saat snapshot
+    // pertama diminta, lalu diperbarui bersama rope sehingga snapshot berikutnya cukup
+    // menyalin akarnya. Dokumen yang tidak pernah di-snapshot tidak menanggung biayanya.
+    DocumentVersions versions;
+    bool versioning;                // true = versions sedang mengikuti isi dokumen
+
+    // Gap buffer untuk baris panjang yang sedang diedit per karakter. Selama gapNode
+    // tidak nullptr, teks terbaru baris itu ada di activeLine (data node sudah usang) dan
+    // textChanged untuk baris itu ditunda; teks baru dikembalikan ke node oleh flushGap
+    // saat baris itu dibaca lewat jalur lain, dipindai, atau di-snapshot.
+    static const size_t GAP_MIN_LENGTH = 256; // Baris lebih pendek diedit langsung di data
+    GapBuffer activeLine;
+    Node* gapNode;
+
+    // Statistik teks baris (kata, codepoint, byte). Dihitung sekali saat pertama
+    // diminta, lalu diperbarui dengan selisih di setiap edit sehingga permintaan
+    // berikutnya O(1). Dokumen yang tidak pernah ditanya statistiknya tidak menanggung
+    // biayanya.
+    TextStats textStats;
+    bool counting;                  // true = textStats sedang mengikuti isi dokumen
+
+    // Indeks kolom (codepoint UTF-8) untuk satu baris panjang, biasanya baris kursor.
+    // Disusun saat kolom baris itu pertama kali diminta, diperbarui oleh edit karakter
+    // di gap buffer, dan dibuang ketika teks baris itu berubah lewat jalur lain.
+    static const size_t COLUMN_INDEX_MIN_LENGTH = 1024; // Baris lebih pendek dipindai langsung
+    CodepointIndex columnIndex;
+    Node* columnNode;               // Baris pemilik columnIndex (nullptr = tidak ada)
+
+    // Jangkar baris untuk riwayat undo/redo. Aksi karakter dan penggantian teks mencatat
+    // jangkar barisnya, bukan nomor baris, sehingga undo/redo langsung menemukan node-nya
+    // dalam O(1) tanpa turun dari akar rope untuk setiap penggantian. Jangkar diberikan saat
+    // baris pertama kali dicatat di riwayat dan tidak pernah dipakai ulang; jika barisnya
+    // dihapus, aksi yang menghapusnya menyimpan jangkar itu dan memasangnya lagi pada node
+    // baru saat baris itu dibuat ulang oleh undo/redo.
+    vector<Node*> anchors;          // anchors[a] = node berjangkar a (nullptr = baris sedang tidak ada); 0 tidak dipakai
+
+    // Jurnal pemulihan: setiap aksi yang dicatat juga ditambahkan ke file jurnal di
+    // samping dokumen, sehingga setelah crash aksi itu bisa diputar ulang di atas file
+    // yang terakhir disimpan. Selain Action::ActionType, jurnal memuat catatan kontrol.
+    //
+    // Undo dan redo dicatat sebagai edit yang benar-benar diterapkannya (aksi baris,
+    // aksi karakter, dan JOURNAL_SPLICE untuk penggantian teks) di dalam BEGIN/COMMIT,
+    // bukan sebagai perintah undo/redo: setelah penyimpanan, jurnal di-rebase dan hanya
+    // memuat catatan sesudah snapshot, sedangkan aksi yang di-undo bisa saja berasal dari
+    // sebelum snapshot. Saat replay, edit itu menjadi satu grup undo biasa. JOURNAL_UNDO
+    // dan JOURNAL_REDO hanya dibaca dari jurnal versi lama.
+    enum JournalRecord { JOURNAL_UNDO = 100, JOURNAL_REDO, JOURNAL_BEGIN, JOURNAL_COMMIT, JOURNAL_BUDGET, JOURNAL_SPLICE };
+    Journal journal;
+    bool journaling;                // false = dokumen tidak diberi jurnal (misalnya benchmark)
+    bool replayingJournal;          // true selama jurnal diputar ulang (catatan tidak ditambahkan lagi)
+    size_t journalEvents;           // Catatan jurnal yang dihasilkan sejak awal (juga tanpa jurnal terbuka)
+    size_t savedJournalEvents;      // journalEvents saat snapshot penyimpanan terakhir diambil
+    uint64_t savedJournalPosition;  // Posisi jurnal saat snapshot penyimpanan terakhir diambil
+
+    // Fungsi untuk menghasilkan prioritas acak bagi node baru
+    unsigned int nextPriority() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    // Fungsi untuk mendapatkan jumlah baris dalam subtree (0 untuk subtree kosong)
+    static int sizeOf(Node* node) {
+        return (node != nullptr) ? node->size : 0;
+    }
+
+    // Fungsi untuk mendapatkan jumlah byte dalam subtree (0 untuk subtree kosong)
+    static size_t bytesOf(Node* node) {
+        return (node != nullptr) ? node->bytes : 0;
+    }
+
+    // Fungsi untuk menghitung ulang ukuran subtree setelah anak-anaknya berubah
+    // sekaligus memperbaiki pointer parent milik anak-anaknya
+    static void update(Node* node) {
+        node->size = node->weight() + sizeOf(node->left) + sizeOf(node->right);
+        node->bytes = node->ownBytes() + bytesOf(node->left) + bytesOf(node->right);
+        if (node->left != nullptr) node->left->parent = node;
+        if (node->right != nullptr) node->right->parent = node;
+    }
+
+    // Fungsi untuk memecah treap: k baris pertama masuk ke a, sisanya ke b.
+    // Baris ke-k harus merupakan awal sebuah node (lihat ensureBoundary).
+    static void split(Node* t, int k, Node*& a, Node*& b) {
+        if (t == nullptr) {
+            a = b = nullptr;
+            return;
+        }
+        if (sizeOf(t->left) + t->weight() <= k) {
+            split(t->right, k - sizeOf(t->left) - t->weight(), t->right, b);
+            a = t;
+        }
+        else {
+            split(t->left, k, a, t->left);
+            b = t;
         }
+        update(t);
+    }
 
-        if (!allReplacements.empty() && record) {
-            // Mencatat aksi REPLACE_TEXT ke undoStack dengan semua penggantian yang dilakukan
-            undoStack.push(Action(Action::REPLACE_TEXT, search, replace, allReplacements));
-            // Kosongkan redoStack karena aksi baru dilakukan
-            while (!redoStack.empty()) redoStack.pop();
-            cout << "Penggantian teks selesai." << endl;
+    // Fungsi untuk menggabungkan dua treap (semua baris a berada sebelum baris b)
+    static Node* merge(Node* a, Node* b) {
+        if (a == nullptr) return b;
+        if (b == nullptr) return a;
+        if (a->priority > b->priority) {
+            a->right = merge(a->right, b);
+            update(a);
+            return a;
         }
-        else if (record) {
-            cout << "Tidak ada kemunculan \"" << search << "\" ditemukan dalam teks." << endl;
+        b->left = merge(a, b->left);
+        update(b);
+        return b;
+    }
+
+    // Fungsi untuk mencari node yang memuat baris ke-position dalam O(log n);
+    // offset diisi dengan posisi baris tersebut di dalam node (0 untuk baris biasa)
+    Node* findNode(int position, int& offset) {
+        Node* node = root;
+        while (node != nullptr) {
+            profiler.visitNodes(1);
+            int leftSize = sizeOf(node->left);
+            if (position < leftSize) {
+                node = node->left;
+            }
+            else if (position < leftSize + node->weight()) {
+                offset = position - leftSize;
+                return node;
+            }
+            else {
+                position -= leftSize + node->weight();
+                node = node->right;
+            }
         }
+        return nullptr;
+    }
 
-        display(); // Menampilkan teks setelah penggantian
+    // Fungsi untuk memastikan baris ke-position menjadi awal sebuah node. Jika baris
+    // itu berada di tengah run, run dipecah menjadi dua run yang bersebelahan.
+    void ensureBoundary(int position) {
+        int offset = 0;
+        Node* run = findNode(position, offset);
+        if (run == nullptr || offset == 0) return;
+
+        // Bagian belakang run menjadi node baru tepat setelah run
+        size_t line = run->sourceLine + offset;
+        size_t restOffset = source->lineStart(line);
+        size_t headBytes = restOffset - run->sourceOffset;
+        Node* rest = createRunNode(line, restOffset, run->runCount - offset, run->runBytes - headBytes);
+        run->runCount = offset;
+        run->runBytes = headBytes;
+        for (Node* node = run; node != nullptr; node = node->parent) update(node);
+
+        Node* before;
+        Node* after;
+        split(root, position, before, after);
+        setRoot(merge(merge(before, rest), after));
+
+        rest->prev = run;
+        rest->next = run->next;
+        if (run->next != nullptr) run->next->prev = rest;
+        else tail = rest;
+        run->next = rest;
     }
 
-    // Fungsi untuk mengganti teks interaktif (mengambil input dari pengguna)
-    void replaceTextInteractive() {
-        string searchTextInput;
-        string replaceTextInput;
+    // Fungsi untuk mendapatkan node baris pada posisi tertentu dalam O(log n). Jika
+    // baris masih berada di dalam run, run dipecah agar baris itu punya node sendiri.
+    Node* nodeAt(int position) {
+        Profiler::Scope scope(profiler, PROFILE_NODE_AT);
+        if (position < 0 || position >= sizeOf(root)) return nullptr;
+        ensureBoundary(position);
+        ensureBoundary(position + 1);
+        int offset = 0;
+        return findNode(position, offset);
+    }
 
-        cout << "Masukkan teks yang ingin dicari: ";
-        getline(cin, searchTextInput);
+    // Fungsi untuk mendapatkan baris setelah node (memecah run bila perlu)
+    Node* nextLine(Node* node) {
+        Node* next = node->next;
+        if (next == nullptr || next->runCount <= 1) return next;
+        return nodeAt(indexOf(node) + 1);
+    }
 
-        if (searchTextInput.empty()) {
-            cout << "Teks pencarian tidak boleh kosong." << endl;
-            return;
+    // Fungsi untuk mendapatkan baris sebelum node (memecah run bila perlu)
+    Node* prevLine(Node* node) {
+        Node* prev = node->prev;
+        if (prev == nullptr || prev->runCount <= 1) return prev;
+        return nodeAt(indexOf(node) - 1);
+    }
+
+    // Fungsi untuk mendapatkan posisi (indeks baris) sebuah node dalam O(log n)
+    // dengan naik dari node ke akar lewat pointer parent
+    int indexOf(Node* node) {
+        if (node == nullptr) return -1;
+        int pos = sizeOf(node->left);
+        while (node->parent != nullptr) {
+            profiler.visitNodes(1);
+            if (node == node->parent->right) {
+                pos += sizeOf(node->parent->left) + node->parent->weight();
+            }
+            node = node->parent;
+        }
+        return pos;
+    }
+
+    // Fungsi untuk mendapatkan offset byte awal baris sebuah node dalam bentuk tersimpan,
+    // dalam O(log n) dengan naik lewat pointer parent seperti indexOf
+    size_t offsetOf(Node* node) {
+        size_t offset = bytesOf(node->left);
+        while (node->parent != nullptr) {
+            profiler.visitNodes(1);
+            if (node == node->parent->right) {
+                offset += bytesOf(node->parent->left) + node->parent->ownBytes();
+            }
+            node = node->parent;
         }
+        return offset;
+    }
 
-        cout << "Masukkan teks pengganti: ";
-        getline(cin, replaceTextInput);
+    // Fungsi untuk mendapatkan posisi baris yang memuat byte ke-offset (offset harus
+    // kurang dari jumlah byte dokumen). Turun dari akar memakai jumlah byte subtree,
+    // lalu di dalam run memakai checkpoint MappedFile tanpa memecah run.
+    int positionAtOffset(size_t offset) {
+        Node* node = root;
+        int position = 0;
+        while (node != nullptr) {
+            profiler.visitNodes(1);
+            size_t leftBytes = bytesOf(node->left);
+            if (offset < leftBytes) {
+                node = node->left;
+                continue;
+            }
+            offset -= leftBytes;
+            position += sizeOf(node->left);
+            if (offset < node->ownBytes()) {
+                if (node->runCount <= 1) return position;
+                size_t line = source->lineOfOffset(node->sourceOffset + offset) - node->sourceLine;
+                return position + min((int)line, node->runCount - 1);
+            }
+            offset -= node->ownBytes();
+            position += node->weight();
+            node = node->right;
+        }
+        return sizeOf(root) - 1;
+    }
 
-        replaceText(searchTextInput, replaceTextInput); // Memanggil fungsi replaceText
+    // Fungsi untuk membaca teks sebuah baris tanpa menyalinnya
+    string_view lineText(Node* node) {
+        if (node == gapNode) flushGap();
+        if (node->runCount == 0) return string_view(node->data);
+        if (node->runCount == 1) return source->lineBetween(node->sourceOffset, node->sourceOffset + node->runBytes);
+        return source->lineAt(node->sourceOffset);
     }
 
-    // Fungsi untuk menampilkan seluruh teks dengan highlighting pada currentNode dan currentCharIndex
-    void display() {
-        Node* current = head;
-        int lineNumber = 1;
-        while (current != nullptr) {
-            // Memeriksa apakah node saat ini adalah currentNode yang di-highlight
-            if (current == currentNode) {
-                // Jika ada indeks karakter yang di-highlight
-                if (currentCharIndex >= 0 && currentCharIndex < current->data.length()) {
-                    string highlighted = current->data;
-                    // Menambahkan tanda kurung siku di sekitar karakter yang di-highlight
-                    highlighted.insert(currentCharIndex + 1, "]");
-                    highlighted.insert(currentCharIndex, "[");
-                    cout << lineNumber << ": " << highlighted;
+    // Fungsi untuk mendapatkan teks baris yang bisa diubah. Baris yang masih dibaca
+    // dari file disalin ke data terlebih dahulu (hanya sekali, saat pertama diedit).
+    LineText& editableText(Node* node) {
+        if (node == gapNode) flushGap();
+        if (node->runCount > 0) {
+            node->data.assign(lineText(node));
+            node->indexKey = (uint32_t)node->sourceLine; // Teks belum berubah, kunci indeks tetap
+            node->runCount = 0;
+            node->anchor = 0; // Menimpa sourceLine yang tidak berlaku lagi
+        }
+        return node->data;
+    }
+
+    // Fungsi untuk menelusuri semua baris secara berurutan tanpa memecah run.
+    // visit(nomorBaris, teks, node) dipanggil untuk setiap baris; node bernilai
+    // nullptr untuk baris yang berada di dalam run berisi lebih dari satu baris.
+    template <typename Visitor>
+    void forEachLine(Visitor visit) {
+        int lineNumber = 0;
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            if (node->runCount <= 1) {
+                visit(lineNumber++, lineText(node), node);
+                continue;
+            }
+            size_t offset = node->sourceOffset;
+            for (int i = 0; i < node->runCount; i++) {
+                string_view text = source->lineAt(offset, &offset);
+                visit(lineNumber++, text, (Node*)nullptr);
+            }
+        }
+    }
+
+    // Fungsi untuk menelusuri count baris mulai dari baris ke-first (seperti forEachLine,
+    // tetapi hanya baris di rentang itu) dalam O(log n + count) tanpa memecah run
+    template <typename Visitor>
+    void forEachLineInRange(int first, int count, Visitor visit) {
+        int end = min(first + count, sizeOf(root));
+        if (first < 0 || first >= end) return;
+        int offset = 0;
+        int lineNumber = first;
+        for (Node* node = findNode(first, offset); node != nullptr && lineNumber < end; node = node->next, offset = 0) {
+            profiler.visitNodes(1);
+            if (node->runCount <= 1) {
+                visit(lineNumber++, lineText(node), node);
+                continue;
+            }
+            size_t position = source->lineStart(node->sourceLine + offset);
+            for (int i = offset; i < node->runCount && lineNumber < end; i++) {
+                string_view text = source->lineAt(position, &position);
+                visit(lineNumber++, text, (Node*)nullptr);
+            }
+        }
+    }
+
+    // Fungsi untuk menelusuri semua kecocokan sebagai (baris, kolom, panjang) yang tidak
+    // saling tumpang tindih. Searcher adalah SubstringSearch (satu kata kunci) atau
+    // PatternSearch (banyak kata / regex). Run dipindai sebagai satu potongan byte yang
+    // bersambung di pemetaan file, sehingga tidak ada biaya pemanggilan per baris;
+    // baris yang teksnya dimiliki node dicari satu per satu. visit(nomorBaris, kolom,
+    // panjang, node) menerima node nullptr untuk baris di dalam run berisi lebih dari
+    // satu baris.
+    template <typename Searcher, typename Visitor>
+    void forEachMatch(const Searcher& search, Visitor visit) {
+        if (search.pattern().empty()) return;
+        flushGap(); // Teks node dibaca langsung dan indeks harus sudah mutakhir
+        vector<uint32_t> candidates;
+        if (index && index->candidates(indexableLiteral(search), candidates)) {
+            forEachCandidateMatch(search, candidates, visit);
+            return;
+        }
+        int lineNumber = 0;
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            if (node->runCount == 0) {
+                size_t pos = 0;
+                size_t length = 0;
+                while ((pos = search.match(node->data, pos, length)) != string::npos) {
+                    visit(lineNumber, (int)pos, (int)length, node);
+                    pos += length;
                 }
-                else {
-                    // Jika tidak ada indeks karakter, highlight seluruh baris
-                    cout << lineNumber << ": [" << current->data << "]";
+            }
+            else {
+                int firstLine = lineNumber;
+                Node* lineNode = (node->runCount == 1) ? node : nullptr;
+                size_t end = source->lineStart(node->sourceLine + node->runCount);
+                search.scanLines(source->data() + node->sourceOffset, end - node->sourceOffset,
+                                 [&](size_t line, size_t column, size_t length) {
+                    visit(firstLine + (int)line, (int)column, (int)length, lineNode);
+                });
+            }
+            lineNumber += node->weight();
+        }
+    }
+
+    // Fungsi untuk mendapatkan kata kunci yang bisa dipersempit lewat indeks trigram;
+    // pola (banyak kata / regex) selalu memindai semua baris
+    static string_view indexableLiteral(const SubstringSearch& search) {
+        return search.pattern();
+    }
+    static string_view indexableLiteral(const PatternSearch&) {
+        return string_view();
+    }
+
+    // Fungsi yang sama dengan forEachMatch, tetapi hanya baris kandidat dari indeks
+    // trigram yang diperiksa. Node dilewati satu per satu tanpa membaca teksnya; baris
+    // kandidat di dalam run langsung dicari lewat nomor barisnya di file.
+    template <typename Searcher, typename Visitor>
+    void forEachCandidateMatch(const Searcher& search, const vector<uint32_t>& candidates, Visitor visit) {
+        if (candidates.empty()) return;
+        auto matchLine = [&](int lineNumber, string_view text, Node* lineNode) {
+            size_t pos = 0;
+            size_t length = 0;
+            while ((pos = search.match(text, pos, length)) != string::npos) {
+                visit(lineNumber, (int)pos, (int)length, lineNode);
+                pos += length;
+            }
+        };
+        int lineNumber = 0;
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            if (node->runCount == 0) {
+                if (binary_search(candidates.begin(), candidates.end(), node->indexKey)) {
+                    matchLine(lineNumber, node->data, node);
                 }
             }
             else {
-                cout << lineNumber << ": " << current->data; // Menampilkan baris tanpa highlight
+                Node* lineNode = (node->runCount == 1) ? node : nullptr;
+                size_t last = node->sourceLine + node->runCount;
+                auto it = lower_bound(candidates.begin(), candidates.end(), (uint32_t)node->sourceLine);
+                for (; it != candidates.end() && *it < last; ++it) {
+                    string_view text = source->lineAt(source->lineStart(*it));
+                    matchLine(lineNumber + (int)(*it - node->sourceLine), text, lineNode);
+                }
+            }
+            lineNumber += node->weight();
+        }
+    }
+
+    // Fungsi untuk mendapatkan kunci indeks sebuah baris: baris file yang belum diedit
+    // memakai nomor barisnya di file, baris lain memakai kunci dari indeks
+    static uint32_t indexKeyOf(Node* node) {
+        return (node->runCount > 0) ? (uint32_t)node->sourceLine : node->indexKey;
+    }
+
+    // Fungsi untuk memperbarui indeks setelah teks sebuah baris berubah: kunci lama
+    // dipensiunkan dan teks baru didaftarkan dengan kunci baru
+    void reindexLine(Node* node) {
+        if (!index) return;
+        index->removeLine(indexKeyOf(node));
+        node->indexKey = index->addLine(lineText(node));
+    }
+
+    // Fungsi yang dipanggil setiap kali teks sebuah baris berubah: indeks pencarian dan
+    // salinan persisten ikut diperbarui
+    void textChanged(Node* node) {
+        if (node == columnNode) columnNode = nullptr;
+        reindexLine(node);
+        if (versioning) versions.assign(indexOf(node), lineText(node));
+        for (Node* ancestor = node; ancestor != nullptr; ancestor = ancestor->parent) {
+            ancestor->bytes = ancestor->ownBytes() + bytesOf(ancestor->left) + bytesOf(ancestor->right);
+        }
+    }
+
+    // Fungsi untuk mengembalikan teks gap buffer ke node pemiliknya lalu menjalankan
+    // textChanged yang tertunda. Dipanggil sebelum teks node dibaca atau dipindai.
+    void flushGap() {
+        if (gapNode == nullptr) return;
+        Node* node = gapNode;
+        Node* indexed = columnNode; // Indeks kolom sudah mengikuti isi gap buffer
+        gapNode = nullptr;
+        node->data.assign(activeLine.text());
+        textChanged(node);
+        columnNode = indexed;
+    }
+
+    // Fungsi untuk menentukan apakah edit karakter pada node memakai gap buffer: baris
+    // yang sudah ada di gap buffer, atau baris yang cukup panjang sehingga menggeser sisa
+    // baris dan menyalinnya ulang ke indeks/salinan persisten pada setiap edit terasa mahal
+    bool usesGap(Node* node) {
+        return node == gapNode || lineText(node).length() >= GAP_MIN_LENGTH;
+    }
+
+    // Fungsi untuk mendapatkan gap buffer berisi teks node. Jika gap buffer sedang
+    // dipakai baris lain, baris itu dikembalikan dulu ke node-nya.
+    GapBuffer& gapText(Node* node) {
+        if (node != gapNode) {
+            flushGap();
+            activeLine.load(string_view(editableText(node)));
+            gapNode = node;
+        }
+        return activeLine;
+    }
+
+    // Fungsi untuk mendapatkan panjang baris tanpa mengembalikan gap buffer ke node
+    size_t lineLength(Node* node) {
+        return (node == gapNode) ? activeLine.length() : lineText(node).length();
+    }
+
+    // Fungsi untuk membaca satu karakter baris tanpa mengembalikan gap buffer ke node
+    char charAt(Node* node, size_t index) {
+        return (node == gapNode) ? activeLine.at(index) : lineText(node)[index];
+    }
+
+    // Fungsi untuk memanggil visit(panjang, at) dengan pembaca byte at(i) untuk baris
+    // node. Baris di gap buffer dibaca langsung dari sana tanpa dikembalikan ke node.
+    template <typename Visitor>
+    size_t withLineBytes(Node* node, Visitor visit) {
+        if (node == gapNode) return visit(activeLine.length(), [this](size_t i) { return activeLine.at(i); });
+        string_view text = lineText(node);
+        return visit(text.size(), [text](size_t i) { return text[i]; });
+    }
+
+    // Fungsi untuk mendapatkan indeks kolom baris node. Baris panjang memakai columnIndex
+    // (disusun bila belum milik baris itu); baris pendek cukup dipindai dari awal.
+    template <typename CharAt>
+    const CodepointIndex& columnsOf(Node* node, size_t length, CharAt at) {
+        static const CodepointIndex unsampled;
+        if (node == columnNode) return columnIndex;
+        if (length < COLUMN_INDEX_MIN_LENGTH) return unsampled;
+        Profiler::Scope scope(profiler, PROFILE_COLUMN_INDEX);
+        columnIndex.build(length, at);
+        columnNode = node;
+        return columnIndex;
+    }
+
+    // Fungsi untuk memperbarui indeks kolom setelah edit karakter di gap buffer baris node
+    void columnsEdited(Node* node, size_t index, size_t removed, size_t inserted, long long columnDelta) {
+        if (node != columnNode) return;
+        withLineBytes(node, [&](size_t length, auto at) {
+            columnIndex.edited(index, removed, inserted, columnDelta, length, at);
+            return length;
+        });
+    }
+
+    // Fungsi untuk mendapatkan kolom (codepoint, dimulai dari 0) dari indeks byte baris node
+    size_t columnAt(Node* node, size_t index) {
+        return withLineBytes(node, [&](size_t length, auto at) {
+            return columnsOf(node, length, at).columnOf(min(index, length), length, at);
+        });
+    }
+
+    // Fungsi untuk mendapatkan indeks byte awal karakter di kolom column baris node;
+    // panjang baris jika baris itu lebih pendek
+    size_t byteAtColumn(Node* node, size_t column) {
+        return withLineBytes(node, [&](size_t length, auto at) {
+            return columnsOf(node, length, at).byteOf(column, length, at);
+        });
+    }
+
+    // Fungsi untuk mendapatkan indeks byte awal karakter UTF-8 yang memuat byte ke-index:
+    // mundur melewati byte lanjutan, paling banyak beberapa byte untuk teks yang valid
+    size_t charStart(Node* node, size_t index) {
+        while (index > 0 && CodepointIndex::isContinuation(charAt(node, index))) index--;
+        return index;
+    }
+
+    // Fungsi untuk mendapatkan panjang byte karakter UTF-8 yang dimulai di byte ke-index
+    size_t charLength(Node* node, size_t index) {
+        size_t length = lineLength(node);
+        size_t end = index + 1;
+        while (end < length && CodepointIndex::isContinuation(charAt(node, end))) end++;
+        return end - index;
+    }
+
+    // Fungsi untuk memperbarui statistik teks sebelum text[position, position +
+    // oldText.size()) pada baris node diganti dengan newText. Hanya potongan yang
+    // berubah dan dua karakter tetangganya yang dibaca, jadi gap buffer tidak dikembalikan.
+    void countReplacement(Node* node, size_t position, string_view oldText, string_view newText) {
+        if (!counting) return;
+        char before = (position > 0) ? charAt(node, position - 1) : ' ';
+        size_t end = position + oldText.size();
+        char after = (end < lineLength(node)) ? charAt(node, end) : ' ';
+        textStats += TextStats::replaced(before, oldText, newText, after);
+    }
+
+    // Fungsi untuk membangun statistik teks dari seluruh dokumen dalam satu kali
+    // penelusuran; sesudahnya statistik diperbarui oleh setiap edit. Run dipindai
+    // sebagai satu potongan byte bersambung beserta akhir barisnya: '\r' dan '\n' adalah
+    // spasi sehingga jumlah kata tetap tepat, sedangkan byte akhir baris ikut terhitung
+    // sama besar di bytes dan codepoints, dan documentStats hanya memakai selisih keduanya.
+    void buildTextStats() {
+        Profiler::Scope scope(profiler, PROFILE_TEXT_STATS);
+        textStats = TextStats();
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            if (node->runCount == 0) {
+                textStats += TextStats::of(lineText(node));
+                continue;
+            }
+            size_t end = min(node->sourceOffset + node->runBytes, source->size()); // Tanpa '\n' tambahan di akhir file
+            textStats += TextStats::of(string_view(source->data() + node->sourceOffset, end - node->sourceOffset));
+        }
+        counting = true;
+    }
+
+    // Fungsi untuk menyisipkan satu karakter ke baris node
+    void insertChar(Node* node, size_t index, char c) {
+        countReplacement(node, index, string_view(), string_view(&c, 1));
+        if (usesGap(node)) {
+            gapText(node).insert(index, c);
+            columnsEdited(node, index, 0, 1, !CodepointIndex::isContinuation(c));
+            return;
+        }
+        editableText(node).insert(index, 1, c);
+        textChanged(node);
+    }
+
+    // Fungsi untuk menghapus satu karakter dari baris node; mengembalikan karakter itu
+    char eraseChar(Node* node, size_t index) {
+        char removed = charAt(node, index);
+        countReplacement(node, index, string_view(&removed, 1), string_view());
+        if (usesGap(node)) {
+            gapText(node).erase(index);
+            columnsEdited(node, index, 1, 0, -(long long)!CodepointIndex::isContinuation(removed));
+            return removed;
+        }
+        editableText(node).erase(index, 1);
+        textChanged(node);
+        return removed;
+    }
+
+    // Fungsi untuk mengganti satu karakter baris node; mengembalikan karakter lama
+    char setChar(Node* node, size_t index, char c) {
+        char old = charAt(node, index);
+        countReplacement(node, index, string_view(&old, 1), string_view(&c, 1));
+        if (usesGap(node)) {
+            gapText(node).set(index, c);
+            columnsEdited(node, index, 1, 1, (long long)!CodepointIndex::isContinuation(c) - !CodepointIndex::isContinuation(old));
+            return old;
+        }
+        editableText(node)[index] = c;
+        textChanged(node);
+        return old;
+    }
+
+    // Fungsi untuk membangun salinan persisten dari rope saat ini dalam satu kali
+    // penelusuran. Prioritas node disalin agar bentuk treap-nya sama.
+    void buildVersions() {
+        flushGap();
+        DocumentVersions::Builder builder;
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            if (node->runCount == 0) builder.addText(node->priority, node->data);
+            else builder.addRun(node->priority, node->sourceLine, node->runCount);
+        }
+        versions.reset(builder.finish(), source);
+        versioning = true;
+    }
+
+    // Fungsi untuk membangun indeks trigram dari seluruh dokumen. Baris file yang belum
+    // diedit didaftarkan lebih dulu dengan nomor barisnya sebagai kunci (menaik), baru
+    // kemudian baris milik node dengan kunci baru, agar setiap daftar tetap terurut.
+    void buildSearchIndex() {
+        Profiler::Scope scope(profiler, PROFILE_BUILD_INDEX);
+        flushGap(); // Indeks lama ikut diperbarui sebelum dibuang
+        size_t fileLines = source ? source->lineCount() : 0;
+        index.reset(new TrigramIndex((uint32_t)fileLines));
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            if (node->runCount == 0) continue;
+            size_t offset = node->sourceOffset;
+            for (int i = 0; i < node->runCount; i++) {
+                index->addLine((uint32_t)(node->sourceLine + i), source->lineAt(offset, &offset));
+            }
+        }
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            if (node->runCount == 0) node->indexKey = index->addLine(node->data);
+        }
+        index->shrinkToFit();
+    }
+
+    // Fungsi untuk memasang akar baru treap setelah split/merge
+    void setRoot(Node* node) {
+        root = node;
+        if (root != nullptr) root->parent = nullptr;
+    }
+
+    // Fungsi untuk membuat node baru di dalam Arena
+    Node* createNode(string_view data) {
+        void* memory = arena.allocate(sizeof(Node));
+        return new (memory) Node(data, &arena);
+    }
+
+    // Fungsi untuk membuat node run yang mewakili count baris file mulai dari line
+    Node* createRunNode(size_t line, size_t offset, int count, size_t bytes) {
+        Node* node = createNode(string_view());
+        node->sourceLine = line;
+        node->sourceOffset = offset;
+        node->runCount = count;
+        node->runBytes = bytes;
+        node->priority = nextPriority();
+        node->size = count;
+        node->bytes = bytes;
+        return node;
+    }
+
+    // Fungsi untuk mendapatkan jangkar baris node, memberinya jangkar baru jika belum
+    // punya. Hanya untuk baris yang teksnya sudah di data (runCount == 0).
+    uint32_t anchorOf(Node* node) {
+        if (node->anchor == 0) {
+            node->anchor = anchors.size();
+            anchors.push_back(node);
+        }
+        return (uint32_t)node->anchor;
+    }
+
+    // Fungsi untuk mendapatkan node berjangkar anchor dalam O(1); nullptr jika barisnya
+    // sedang tidak ada di dokumen
+    Node* anchoredNode(uint32_t anchor) {
+        return (anchor < anchors.size()) ? anchors[anchor] : nullptr;
+    }
+
+    // Fungsi untuk memasang kembali jangkar lama pada node baris yang dibuat ulang
+    void bindAnchor(Node* node, uint32_t anchor) {
+        if (node == nullptr || anchor == 0 || anchor >= anchors.size()) return;
+        node->anchor = anchor;
+        anchors[anchor] = node;
+    }
+
+    // Fungsi untuk menghancurkan node dan mengembalikan memorinya ke Arena
+    void destroyNode(Node* node) {
+        if (node == gapNode) gapNode = nullptr; // Perubahan tertunda ikut hilang bersama barisnya
+        if (node == columnNode) columnNode = nullptr;
+        if (node->runCount == 0 && node->anchor != 0) anchors[node->anchor] = nullptr;
+        node->~Node();
+        arena.deallocate(node, sizeof(Node));
+    }
+
+    // Fungsi untuk mengosongkan redoStack karena aksi baru dilakukan
+    void clearRedoStack() {
+        redoStack.clear();
+    }
+
+    // Fungsi untuk mencatat aksi baru ke undoStack. Di dalam transaksi, aksi menjadi
+    // anggota grup transaksi. Di luar transaksi, edit karakter berturut-turut dengan jenis
+    // yang sama pada baris yang sama digabung menjadi satu grup: penanda GROUP di puncak
+    // undoStack diganti dengan penanda baru yang mencakup edit terbaru.
+    void recordAction(const Action& action) {
+        if (action.type != Action::REPLACE_PATTERN) journalAction(action); // Pola dicatat oleh replacePattern
+        clearRedoStack(); // Kosongkan redoStack karena aksi baru dilakukan
+        if (transactionDepth > 0) {
+            undoStack.push(action);
+            transactionActions++;
+            return;
+        }
+
+        bool charEdit = (action.type == Action::DELETE_CHAR || action.type == Action::REPLACE_CHAR);
+        if (charEdit && coalesceCount > 0 && action.type == coalesceType && action.linePosition == coalesceLine) {
+            undoStack.holdBudget(); // Anggota grup tidak boleh terbuang sebelum penandanya masuk
+            if (coalesceCount > 1) undoStack.pop(); // Penanda grup yang lama
+            undoStack.push(action);
+            coalesceCount++;
+            undoStack.push(Action(Action::GROUP, coalesceCount));
+            undoStack.releaseBudget();
+            return;
+        }
+
+        undoStack.push(action);
+        coalesceCount = charEdit ? 1 : 0;
+        coalesceType = action.type;
+        coalesceLine = action.linePosition;
+    }
+
+    // Fungsi untuk menambahkan aksi ke jurnal. Hanya data yang dibutuhkan untuk
+    // mengulang aksi yang disimpan; teks lama dibaca ulang dari dokumen saat replay.
+    void journalAction(const Action& action, bool regex = false) {
+        if (replayingJournal) return;
+        journalEvents++;
+        if (!journal.isOpen()) return;
+        string record(1, (char)action.type);
+        switch (action.type) {
+            case Action::INSERT_LINE:
+                Journal::putVarint(record, action.linePosition);
+                Journal::putString(record, action.data);
+                break;
+            case Action::DELETE_LINE:
+                Journal::putVarint(record, action.linePosition);
+                break;
+            case Action::INSERT_CHAR:
+            case Action::DELETE_CHAR:
+            case Action::REPLACE_CHAR:
+                Journal::putVarint(record, action.linePosition);
+                Journal::putVarint(record, action.charIndex);
+                if (action.type != Action::DELETE_CHAR) record.push_back(action.newChar);
+                break;
+            case Action::REPLACE_PATTERN:
+                record.push_back(regex ? 1 : 0);
+                // fallthrough
+            case Action::REPLACE_TEXT:
+                Journal::putString(record, action.searchText);
+                Journal::putString(record, action.replaceWithText);
+                break;
+            default:
+                return; // GROUP tidak pernah dicatat langsung
+        }
+        journal.append(record);
+    }
+
+    // Fungsi untuk menambahkan catatan kontrol (undo, redo, transaksi, batas riwayat)
+    void journalControl(JournalRecord kind, uint64_t value = 0) {
+        if (replayingJournal) return;
+        journalEvents++;
+        if (!journal.isOpen()) return;
+        string record(1, (char)kind);
+        if (kind == JOURNAL_BUDGET) Journal::putVarint(record, value);
+        journal.append(record);
+    }
+
+    // Fungsi untuk menambahkan catatan JOURNAL_SPLICE: length byte di baris line mulai
+    // dari offset diganti dengan text (dipakai untuk penggantian teks oleh undo/redo)
+    void journalSplice(int line, size_t offset, size_t length, string_view text) {
+        if (replayingJournal) return;
+        journalEvents++;
+        if (!journal.isOpen()) return;
+        string record(1, (char)JOURNAL_SPLICE);
+        Journal::putVarint(record, line);
+        Journal::putVarint(record, offset);
+        Journal::putVarint(record, length);
+        Journal::putString(record, text);
+        journal.append(record);
+    }
+
+    // Fungsi untuk memutar ulang satu catatan jurnal lewat operasi editor biasa.
+    // Mengembalikan false jika catatan tidak bisa dibaca (replay berhenti di sini).
+    bool replayRecord(string_view payload) {
+        Journal::Reader in(payload);
+        int kind = in.byte();
+        switch (kind) {
+            case Action::INSERT_LINE: {
+                int position = (int)in.varint();
+                string_view data = in.string();
+                if (!in.ok() || !in.atEnd()) return false;
+                insertLine(position, data);
+                return true;
+            }
+            case Action::DELETE_LINE: {
+                int position = (int)in.varint();
+                if (!in.ok() || !in.atEnd()) return false;
+                deleteLine(position);
+                return true;
+            }
+            case Action::INSERT_CHAR:
+            case Action::DELETE_CHAR:
+            case Action::REPLACE_CHAR: {
+                // Aksi karakter dicatat per byte, jadi diputar ulang per byte juga
+                int position = (int)in.varint();
+                int charIndex = (int)in.varint();
+                char newChar = (kind != Action::DELETE_CHAR) ? (char)in.byte() : '\0';
+                if (!in.ok() || !in.atEnd()) return false;
+                Node* node = nodeAt(position);
+                if (node == nullptr) return false;
+                currentNode = node;
+                currentCharIndex = charIndex;
+                int limit = (int)lineLength(node) + (kind == Action::INSERT_CHAR ? 1 : 0);
+                if (charIndex >= 0 && charIndex < limit) editCurrentByte((Action::ActionType)kind, charIndex, newChar, true);
+                return true;
+            }
+            case Action::REPLACE_TEXT: {
+                string search(in.string());
+                string replace(in.string());
+                if (!in.ok() || !in.atEnd()) return false;
+                replaceText(search, replace);
+                return true;
+            }
+            case Action::REPLACE_PATTERN: {
+                bool regex = in.byte() != 0;
+                string text(in.string());
+                string replace(in.string());
+                if (!in.ok() || !in.atEnd()) return false;
+                PatternSearch pattern;
+                string error;
+                if (!compilePattern(regex, text, pattern, error)) return false;
+                replacePattern(pattern, replace);
+                return true;
+            }
+            case JOURNAL_BUDGET: {
+                uint64_t budget = in.varint();
+                if (!in.ok() || !in.atEnd()) return false;
+                undoStack.setBudget((size_t)budget);
+                return true;
+            }
+            case JOURNAL_SPLICE: {
+                int position = (int)in.varint();
+                size_t offset = (size_t)in.varint();
+                size_t length = (size_t)in.varint();
+                string_view text = in.string();
+                if (!in.ok() || !in.atEnd()) return false;
+                Node* node = nodeAt(position);
+                if (node == nullptr || offset + length > lineLength(node)) return false;
+                spliceLine(node, offset, length, text);
+                return true;
+            }
+            case JOURNAL_UNDO:
+            case JOURNAL_REDO:
+            case JOURNAL_BEGIN:
+            case JOURNAL_COMMIT:
+                if (!in.atEnd()) return false;
+                if (kind == JOURNAL_UNDO) undo();
+                else if (kind == JOURNAL_REDO) redo();
+                else if (kind == JOURNAL_BEGIN) beginTransaction();
+                else commitTransaction();
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Fungsi untuk membuka jurnal dokumen path. Jurnal yang tertinggal dari sesi yang
+    // crash diputar ulang di atas file; waktunya sebanding dengan panjang jurnal.
+    void openJournal(const string& path) {
+        Journal::FileIdentity identity;
+        if (!journaling || !Journal::identify(path, identity)) return;
+
+        ios_base::iostate state = cout.rdstate();
+        bool wasRendering = rendering;
+        cout.setstate(ios::badbit); // Pesan setiap aksi yang diputar ulang disembunyikan
+        rendering = false;
+        replayingJournal = true;
+        size_t applied = 0;
+        auto start = chrono::steady_clock::now();
+        Journal::OpenStatus status = journal.open(path + ".journal", identity, [&](string_view record) {
+            if (!replayRecord(record)) return false;
+            applied++;
+            return true;
+        });
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        replayingJournal = false;
+        rendering = wasRendering;
+        cout.clear(state);
+
+        // Transaksi yang belum di-commit saat crash ditutup (dan dicatat) di sini
+        while (transactionDepth > 0) commitTransaction();
+        if (status == Journal::RECOVERED && applied > 0) {
+            cout << "Memulihkan " << applied << " aksi dari jurnal \"" << journal.filePath() << "\" dalam "
+                 << (long long)elapsed.count() << " ms." << endl;
+        }
+        else if (status == Journal::REPLACED_STALE) {
+            cout << "Jurnal \"" << path << ".journal\" tidak cocok dengan isi file dan dipindahkan ke \""
+                 << path << ".journal.old\"." << endl;
+        }
+        else if (status == Journal::FAILED) {
+            cout << "Jurnal \"" << path << ".journal\" tidak bisa dibuka; perubahan tidak terlindungi dari crash." << endl;
+        }
+    }
+
+    // Fungsi untuk mendapatkan posisi baris saat ini dalam linked list
+    int getCurrentLinePosition() {
+        return indexOf(currentNode);
+    }
+
+public:
+    // Konstruktor untuk LinkedList. strings adalah pool string riwayat; buffer-buffer
+    // dalam satu Workspace memakai pool yang sama.
+    explicit LinkedList(shared_ptr<StringPool> strings = make_shared<StringPool>())
+        : historyStrings(move(strings)), undoStack(*historyStrings), redoStack(*historyStrings),
+          profiler(PROFILE_NAMES, PROFILE_COUNT) {
+        profiler.setByteCounter(arena.allocationCounter());
+        undoStack.setBudget(DEFAULT_HISTORY_BUDGET);
+        transactionDepth = 0;
+        transactionActions = 0;
+        coalesceCount = 0;
+        coalesceLine = -1;
+        coalesceType = Action::DELETE_CHAR;
+        head = nullptr;
+        tail = nullptr;
+        currentNode = nullptr;
+        currentCharIndex = 0;
+        root = nullptr;
+        seed = 2463534242u;
+        rendering = true;
+        versioning = false;
+        gapNode = nullptr;
+        counting = false;
+        columnNode = nullptr;
+        anchors.assign(1, nullptr);
+        journaling = true;
+        replayingJournal = false;
+        journalEvents = 0;
+        savedJournalEvents = 0;
+        savedJournalPosition = 0;
+    }
+
+    // Destruktor untuk membersihkan memori yang dialokasikan. Node dan teks baris
+    // seluruhnya berada di arena, jadi cukup dilepas sekaligus.
+    ~LinkedList() {
+        arena.release();
+    }
+
+    // Fungsi untuk mengosongkan dokumen beserta riwayat undo/redo-nya
+    void clear() {
+        arena.release();
+        undoStack.clear();
+        undoStack.releaseBudget(); // Transaksi yang belum selesai ikut dibuang
+        redoStack.clear();
+        transactionDepth = 0;
+        transactionActions = 0;
+        coalesceCount = 0;
+        head = tail = root = currentNode = nullptr;
+        currentCharIndex = 0;
+        source.reset();
+        index.reset();
+        versions.clear(); // Snapshot yang masih dipegang pembaca lain tetap utuh
+        versioning = false;
+        gapNode = nullptr;
+        activeLine.clear();
+        textStats = TextStats();
+        counting = false;
+        columnIndex.clear();
+        columnNode = nullptr;
+        vector<Node*>(1, nullptr).swap(anchors);
+    }
+
+    // Fungsi untuk membuka file lewat pemetaan memori. Saat dibuka hanya indeks offset
+    // baris yang dibangun dan seluruh isi file menjadi satu run; sebuah baris baru
+    // disalin ke memori ketika diedit. Dokumen dan riwayat sebelumnya dibuang.
+    bool openFile(const string& path) {
+        string error;
+        shared_ptr<MappedFile> file = loadFile(path, error);
+        if (!file) {
+            cout << error << endl;
+            return false;
+        }
+        return adoptFile(file, path);
+    }
+
+    // Fungsi untuk memetakan file dan membangun indeks offset barisnya tanpa menyentuh
+    // dokumen mana pun, sehingga aman dijalankan di thread lain. Mengembalikan nullptr
+    // (dan mengisi error) jika file tidak bisa dipakai.
+    static shared_ptr<MappedFile> loadFile(const string& path, string& error) {
+        shared_ptr<MappedFile> file = make_shared<MappedFile>();
+        if (!file->open(path)) {
+            error = "Gagal membuka file \"" + path + "\".";
+            return nullptr;
+        }
+        if (file->lineCount() > (size_t)INT_MAX) {
+            error = "File \"" + path + "\" memiliki terlalu banyak baris.";
+            return nullptr;
+        }
+        return file;
+    }
+
+    // Fungsi untuk memasang file yang sudah dipetakan oleh loadFile sebagai isi dokumen.
+    // Dokumen dan riwayat sebelumnya dibuang.
+    bool adoptFile(shared_ptr<MappedFile> file, const string& path) {
+        Profiler::Scope scope(profiler, PROFILE_OPEN_FILE);
+        bool indexed = (index != nullptr); // Indeks yang aktif dibangun ulang untuk file baru
+        finishSave(true, cout); // Jurnal dokumen lama dipindahkan dulu jika sedang disimpan
+        closeJournal();         // Perubahan dokumen lama dibuang, begitu juga jurnalnya
+        clear();
+        source = file;
+        if (source->lineCount() > 0) {
+            // Baris terakhir tanpa newline tetap dihitung dengan '\n', sama seperti saat disimpan
+            bool finalNewline = source->data()[source->size() - 1] == '\n';
+            Node* run = createRunNode(0, 0, (int)source->lineCount(), source->size() + (finalNewline ? 0 : 1));
+            head = tail = run;
+            setRoot(run);
+            currentNode = nodeAt(0); // Baris pertama mendapat node sendiri untuk kursor
+        }
+        if (indexed) buildSearchIndex();
+        documentPath = path;
+        cout << "File \"" << path << "\" dibuka: " << source->lineCount() << " baris, "
+             << source->size() << " byte." << endl;
+        openJournal(path);
+        return true;
+    }
+
+    // Fungsi untuk mendapatkan jumlah baris dalam dokumen
+    int getLineCount() const {
+        return sizeOf(root);
+    }
+
+    // Fungsi untuk mendapatkan path file dokumen (kosong jika belum pernah dibuka/disimpan)
+    const string& getDocumentPath() const {
+        return documentPath;
+    }
+
+    // Fungsi untuk mendapatkan byte riwayat undo/redo yang masih berada di memori
+    // (tanpa pool string, yang bisa dipakai bersama buffer lain)
+    size_t historyBytes() const {
+        return undoStack.bytesReserved() + redoStack.bytesReserved();
+    }
+
+    // Fungsi untuk memeriksa apakah riwayat undo/redo sedang berada di file sementara
+    bool historySpilled() const {
+        return undoStack.spilled() || redoStack.spilled();
+    }
+
+    // Fungsi untuk merapatkan riwayat undo/redo; mengembalikan byte yang dilepas
+    size_t compactHistory() {
+        return undoStack.compact() + redoStack.compact();
+    }
+
+    // Fungsi untuk memindahkan riwayat undo/redo ke file sementara; riwayat dibaca
+    // kembali otomatis saat undo/redo berikutnya. Mengembalikan byte yang dilepas.
+    size_t spillHistory() {
+        return undoStack.spill() + redoStack.spill();
+    }
+
+    // Fungsi untuk mendapatkan jumlah byte Arena (node dan teks baris) yang sedang dipakai
+    size_t getArenaBytesInUse() const {
+        return arena.bytesInUse();
+    }
+
+    // Fungsi untuk menyisipkan baris baru pada posisi tertentu; mengembalikan node-nya
+    Node* insertLine(int position, string_view data, bool record = true) {
+        Profiler::Scope scope(profiler, PROFILE_INSERT_LINE);
+        int count = sizeOf(root);
+        // Posisi di luar batas disesuaikan: negatif ke awal, melebihi jumlah baris ke akhir
+        if (position < 0) position = 0;
+        if (position > count) position = count;
+
+        Node* newNode = createNode(data); // Membuat node baru dengan data yang diberikan
+        newNode->priority = nextPriority();
+        if (index) newNode->indexKey = index->addLine(data);
+        if (counting) textStats += TextStats::of(data);
+
+        // Menautkan node baru di antara tetangganya pada linked list
+        ensureBoundary(position); // Jika posisi berada di tengah run, run dipecah dulu
+        int offset = 0;
+        Node* nextNode = (position < count) ? findNode(position, offset) : nullptr;
+        Node* prevNode = (nextNode != nullptr) ? nextNode->prev : tail;
+        newNode->prev = prevNode;
+        newNode->next = nextNode;
+        if (prevNode != nullptr) prevNode->next = newNode;
+        else head = newNode;     // Menyisipkan di posisi pertama, update head
+        if (nextNode != nullptr) nextNode->prev = newNode;
+        else tail = newNode;     // Menyisipkan di akhir, update tail
+
+        // Menyisipkan node ke dalam rope pada posisi yang sama
+        Node* before;
+        Node* after;
+        split(root, position, before, after);
+        setRoot(merge(merge(before, newNode), after));
+        if (versioning) versions.insert(position, data);
+
+        // Jika sebelumnya linked list kosong, set currentNode ke baris pertama
+        if (currentNode == nullptr) {
+            currentNode = newNode;
+        }
+
+        if (record) {
+            // Mencatat aksi INSERT_LINE ke undoStack
+            recordAction(Action(Action::INSERT_LINE, position, data));
+        }
+        return newNode;
+    }
+
+    // Fungsi untuk menghapus baris pada posisi tertentu. Mengembalikan jangkar baris itu
+    // (0 jika tidak punya) agar aksi yang kelak membuatnya ulang bisa memasangnya lagi.
+    uint32_t deleteLine(int position, bool record = true) {
+        Profiler::Scope scope(profiler, PROFILE_DELETE_LINE);
+        if (head == nullptr) return 0; // Tidak ada baris untuk dihapus
+        if (position < 0 || position >= sizeOf(root)) return 0; // Posisi tidak valid
+
+        // Mengeluarkan node pada posisi tersebut dari rope
+        nodeAt(position); // Memastikan baris itu punya node sendiri
+        Node* before;
+        Node* rest;
+        Node* toDelete;
+        split(root, position, before, rest);
+        split(rest, 1, toDelete, rest);
+        setRoot(merge(before, rest));
+        if (versioning) versions.erase(position);
+        if (counting) textStats -= TextStats::of(lineText(toDelete));
+
+        uint32_t anchor = (toDelete->runCount == 0) ? (uint32_t)toDelete->anchor : 0;
+        if (record) {
+            // Mencatat aksi DELETE_LINE (beserta data barisnya) ke undoStack
+            Action action(Action::DELETE_LINE, position, lineText(toDelete));
+            action.anchor = anchor;
+            recordAction(action);
+        }
+
+        // Menghapus node dari linked list (head dan tail diperbarui terpisah
+        // agar tail tidak menggantung saat baris terakhir yang tersisa dihapus)
+        Node* prevNode = toDelete->prev;
+        Node* nextNode = toDelete->next;
+        if (prevNode != nullptr) prevNode->next = nextNode;
+        else head = nextNode;
+        if (nextNode != nullptr) nextNode->prev = prevNode;
+        else tail = prevNode;
+
+        // Jika node yang dihapus adalah currentNode, perbarui currentNode ke baris
+        // berikutnya, atau ke baris sebelumnya jika yang dihapus adalah baris terakhir
+        if (toDelete == currentNode) {
+            int remaining = sizeOf(root);
+            if (position < remaining) {
+                currentNode = nodeAt(position);
+                currentCharIndex = 0;
+            }
+            else if (remaining > 0) {
+                currentNode = nodeAt(remaining - 1);
+                size_t length = lineLength(currentNode);
+                currentCharIndex = (length > 0) ? (int)charStart(currentNode, length - 1) : 0;
+            }
+            else {
+                currentNode = nullptr;
+                currentCharIndex = 0;
+            }
+        }
+
+        if (index) index->removeLine(indexKeyOf(toDelete));
+        destroyNode(toDelete); // Menghapus node dari memori
+        return anchor;
+    }
+
+    // Fungsi untuk mengubah satu byte baris saat ini lalu mencatatnya: DELETE_CHAR
+    // menghapus byte ke-index, REPLACE_CHAR menggantinya dengan c, dan INSERT_CHAR
+    // menyisipkan c di sana. Karakter UTF-8 multi-byte diubah dengan beberapa panggilan.
+    char editCurrentByte(Action::ActionType kind, size_t index, char c, bool record) {
+        char old = '\0';
+        if (kind == Action::DELETE_CHAR) old = eraseChar(currentNode, index);
+        else if (kind == Action::REPLACE_CHAR) old = setChar(currentNode, index, c);
+        else insertChar(currentNode, index, c);
+        if (record) {
+            int linePos = getCurrentLinePosition(); // Mendapatkan posisi baris saat ini
+            if (linePos != -1) {
+                Action action(kind, linePos, (int)index, old, c);
+                action.anchor = anchorOf(currentNode);
+                recordAction(action);
+            }
+        }
+        return old;
+    }
+
+    // Fungsi untuk memastikan currentCharIndex berada di awal sebuah karakter UTF-8.
+    // Mengembalikan false (dengan pesan) jika tidak ada karakter di posisi kursor.
+    bool alignCursor() {
+        if (currentNode == nullptr) {
+            cout << "Tidak ada baris tersedia." << endl;
+            return false;
+        }
+        if (currentCharIndex < 0 || currentCharIndex >= (int)lineLength(currentNode)) {
+            cout << "Indeks karakter saat ini di luar batas." << endl;
+            return false;
+        }
+        currentCharIndex = (int)charStart(currentNode, currentCharIndex);
+        return true;
+    }
+
+    // Fungsi untuk menghapus karakter (satu codepoint UTF-8 utuh) pada posisi saat ini.
+    // Setiap byte dicatat sebagai DELETE_CHAR di indeks yang sama; edit karakter
+    // berturut-turut pada satu baris digabung, jadi satu undo mengembalikan semuanya.
+    void deleteCurrentChar(bool record = true) {
+        Profiler::Scope scope(profiler, PROFILE_DELETE_CHAR);
+        if (!alignCursor()) return;
+
+        size_t column = columnAt(currentNode, currentCharIndex);
+        size_t length = charLength(currentNode, currentCharIndex);
+        string deleted;
+        for (size_t i = 0; i < length; i++) {
+            deleted.push_back(editCurrentByte(Action::DELETE_CHAR, currentCharIndex, '\0', record));
+        }
+        cout << "Menghapus karakter '" << deleted << "' pada posisi " << column << "." << endl;
+
+        // Menyesuaikan indeks karakter ke karakter terakhir jika yang dihapus adalah
+        // karakter terakhir baris
+        size_t remaining = lineLength(currentNode);
+        if (currentCharIndex >= (int)remaining && remaining > 0) {
+            currentCharIndex = (int)charStart(currentNode, remaining - 1);
+        }
+
+        display(); // Menampilkan teks setelah penghapusan
+    }
+
+    // Fungsi untuk mengganti karakter pada posisi saat ini dengan karakter pertama
+    // newChar (satu codepoint UTF-8). Byte yang sama panjang diganti di tempat; jika
+    // panjangnya berbeda, sisa byte dihapus atau disisipkan dalam satu transaksi agar
+    // penggantian tetap di-undo sekaligus.
+    void replaceCurrentChar(string_view newChar, bool record = true) {
+        Profiler::Scope scope(profiler, PROFILE_REPLACE_CHAR);
+        if (!alignCursor()) return;
+        if (newChar.empty()) {
+            cout << "Karakter pengganti tidak boleh kosong." << endl;
+            return;
+        }
+        size_t newLength = 1;
+        while (newLength < newChar.size() && CodepointIndex::isContinuation(newChar[newLength])) newLength++;
+        newChar = newChar.substr(0, newLength);
+
+        size_t column = columnAt(currentNode, currentCharIndex);
+        size_t oldLength = charLength(currentNode, currentCharIndex);
+        bool grouped = record && oldLength != newLength;
+        if (grouped) beginTransaction();
+        string oldChar;
+        size_t common = min(oldLength, newLength);
+        for (size_t i = 0; i < common; i++) {
+            oldChar.push_back(editCurrentByte(Action::REPLACE_CHAR, currentCharIndex + i, newChar[i], record));
+        }
+        for (size_t i = common; i < oldLength; i++) {
+            oldChar.push_back(editCurrentByte(Action::DELETE_CHAR, currentCharIndex + common, '\0', record));
+        }
+        for (size_t i = common; i < newLength; i++) {
+            editCurrentByte(Action::INSERT_CHAR, currentCharIndex + i, newChar[i], record);
+        }
+        if (grouped) commitTransaction();
+        cout << "Mengganti karakter '" << oldChar << "' dengan '" << newChar << "' pada posisi " << column << "." << endl;
+
+        display(); // Menampilkan teks setelah penggantian
+    }
+
+    // Fungsi untuk mengganti length byte di baris node mulai dari offset dengan text, lalu
+    // mencatatnya sebagai REPLACE_PATTERN dengan satu penggantian (teks lama ikut disimpan).
+    // Dipakai replay JOURNAL_SPLICE.
+    void spliceLine(Node* node, size_t offset, size_t length, string_view text) {
+        LineText& line = editableText(node);
+        string oldText(line.data() + offset, length);
+        countReplacement(node, offset, oldText, text);
+        line.replace(offset, length, text.data(), text.length());
+        textChanged(node);
+        vector<Action::Replacement> reps(1, Action::Replacement{ anchorOf(node), (int)offset });
+        recordAction(Action(oldText, text, reps, vector<int>(1, (int)length), oldText));
+    }
+
+    // Fungsi untuk mengganti teks berdasarkan pencarian sederhana
+    void replaceText(const string& search, const string& replace, bool record = true) {
+        Profiler::Scope scope(profiler, PROFILE_REPLACE_TEXT);
+        if (search.empty()) {
+            cout << "Kata kunci pencarian tidak boleh kosong." << endl;
+            return;
+        }
+
+        vector<Action::Replacement> allReplacements; // Menyimpan semua penggantian yang dilakukan
+
+        // Tahap 1: kumpulkan baris yang memuat kata kunci tanpa mengubah apa pun,
+        // sehingga baris file yang tidak cocok tetap dibaca langsung dari pemetaan
+        SubstringSearch searcher(search);
+        vector<pair<int, Node*>> matchedLines;
+        forEachMatch(searcher, [&](int linePos, int, int, Node* node) {
+            if (matchedLines.empty() || matchedLines.back().first != linePos) {
+                matchedLines.push_back(make_pair(linePos, node));
+            }
+        });
+
+        // Tahap 2: lakukan penggantian hanya pada baris yang cocok
+        for (const auto& match : matchedLines) {
+            int linePos = match.first;
+            Node* current = (match.second != nullptr) ? match.second : nodeAt(linePos);
+            LineText& text = editableText(current);
+            uint32_t anchor = anchorOf(current);
+            size_t pos = 0;
+            // Cari semua kemunculan kata kunci dalam baris
+            while ((pos = searcher.find(text, pos)) != string::npos) {
+                // Simpan informasi penggantian sebelum dilakukan
+                Action::Replacement rep;
+                rep.anchor = anchor;
+                rep.charIdx = pos;
+                allReplacements.push_back(rep);
+
+                // Ganti kata kunci dengan teks pengganti
+                countReplacement(current, pos, search, replace);
+                text.replace(pos, search.length(), replace);
+                cout << "Mengganti \"" << search << "\" dengan \"" << replace << "\" di baris " << linePos + 1 << ", posisi " << pos + 1 << "." << endl;
+
+                pos += replace.length(); // Pindah posisi untuk pencarian berikutnya
+            }
+            textChanged(current);
+        }
+
+        if (!allReplacements.empty() && record) {
+            // Mencatat aksi REPLACE_TEXT ke undoStack dengan semua penggantian yang dilakukan
+            recordAction(Action(Action::REPLACE_TEXT, search, replace, allReplacements));
+            cout << "Penggantian teks selesai." << endl;
+        }
+        else if (record) {
+            cout << "Tidak ada kemunculan \"" << search << "\" ditemukan dalam teks." << endl;
+        }
+
+        display(); // Menampilkan teks setelah penggantian
+    }
+
+    // Fungsi untuk mengganti teks secara paralel. Rentang baris dibagi menjadi beberapa
+    // potongan yang dicari dan ditulis ulang bersamaan oleh thread pool; setiap potongan
+    // menghasilkan teks baru dan daftar Replacement-nya sendiri tanpa menyentuh rope atau
+    // Arena (keduanya tidak thread-safe). Hasil digabung menurut urutan potongan, lalu
+    // dipasang ke node oleh thread utama, sehingga catatan REPLACE_TEXT yang dihasilkan
+    // sama persis dengan replaceText biasa, berapa pun jumlah thread-nya.
+    void replaceTextParallel(const string& search, const string& replace, bool record = true) {
+        Profiler::Scope scope(profiler, PROFILE_REPLACE_PARALLEL);
+        if (search.empty()) {
+            cout << "Kata kunci pencarian tidak boleh kosong." << endl;
+            return;
+        }
+        flushGap(); // Thread pool membaca teks node secara langsung
+        if (!workers) workers.reset(new ThreadPool());
+
+        // Bagian dokumen yang dikerjakan satu tugas: count baris mulai dari baris ke-first
+        // di dalam node (node run boleh dibagi ke beberapa tugas tanpa dipecah)
+        struct Segment {
+            Node* node;
+            int linePos; // Posisi baris pertama segmen dalam dokumen
+            int first;   // Indeks baris pertama segmen di dalam node
+            int count;   // Jumlah baris dalam segmen
+        };
+        // Baris yang berubah beserta teks barunya
+        struct LineEdit {
+            int linePos;
+            Node* node; // nullptr untuk baris di dalam run berisi lebih dari satu baris
+            string text;
+            size_t replacements; // Jumlah penggantian di baris ini
+        };
+        struct TaskResult {
+            vector<LineEdit> edits;
+            vector<Action::Replacement> replacements;
+        };
+
+        // Membagi baris secara merata ke beberapa tugas (lebih banyak dari jumlah thread
+        // agar pekerja yang selesai lebih dulu bisa mengambil sisa pekerjaan)
+        const int MIN_LINES_PER_TASK = 4096;
+        int lineCount = sizeOf(root);
+        int taskCount = (int)workers->size() * 4;
+        if (taskCount > lineCount / MIN_LINES_PER_TASK) taskCount = lineCount / MIN_LINES_PER_TASK;
+        if (taskCount < 1) taskCount = 1;
+
+        vector<vector<Segment>> tasks(taskCount);
+        int linePos = 0;
+        for (Node* node = head; node != nullptr; node = node->next) {
+            profiler.visitNodes(1);
+            int first = 0;
+            while (first < node->weight()) {
+                int task = (int)((long long)linePos * taskCount / lineCount);
+                int taskEnd = (int)(((long long)(task + 1) * lineCount + taskCount - 1) / taskCount);
+                int count = min(node->weight() - first, taskEnd - linePos);
+                tasks[task].push_back(Segment{ node, linePos, first, count });
+                first += count;
+                linePos += count;
+            }
+        }
+
+        SubstringSearch searcher(search);
+        const MappedFile* file = source.get();
+        vector<TaskResult> results(taskCount);
+
+        // Menulis ulang satu baris dengan aturan yang sama seperti replaceText
+        auto rewrite = [&](TaskResult& result, int pos, Node* node, string_view original) {
+            LineEdit edit{ pos, node, string(original), 0 };
+            size_t at = 0;
+            while ((at = searcher.find(edit.text, at)) != string::npos) {
+                // Jangkar baris baru diberikan thread utama saat hasil dipasang
+                result.replacements.push_back(Action::Replacement{ 0, (int)at });
+                edit.replacements++;
+                edit.text.replace(at, search.length(), replace);
+                at += replace.length();
+            }
+            result.edits.push_back(move(edit));
+        };
+
+        for (int t = 0; t < taskCount; t++) {
+            workers->submit([&, t]() {
+                TaskResult& result = results[t];
+                for (const Segment& segment : tasks[t]) {
+                    Node* node = segment.node;
+                    if (node->runCount == 0) {
+                        if (searcher.find(node->data) != string::npos) rewrite(result, segment.linePos, node, node->data);
+                        continue;
+                    }
+                    // Baris dari file dipindai sebagai satu potongan bersambung
+                    Node* lineNode = (node->runCount == 1) ? node : nullptr;
+                    size_t begin = file->lineStart(node->sourceLine + segment.first);
+                    size_t end = file->lineStart(node->sourceLine + segment.first + segment.count);
+                    int cursorLine = 0;        // Baris (relatif) yang offset awalnya diketahui
+                    size_t cursorOffset = begin;
+                    int lastLine = -1;
+                    searcher.scanLines(file->data() + begin, end - begin, [&](size_t line, size_t, size_t) {
+                        if ((int)line == lastLine) return; // Baris ini sudah ditulis ulang
+                        lastLine = (int)line;
+                        while (cursorLine < (int)line) {
+                            file->lineAt(cursorOffset, &cursorOffset);
+                            cursorLine++;
+                        }
+                        rewrite(result, segment.linePos + (int)line, lineNode, file->lineAt(cursorOffset));
+                    });
+                }
+            });
+        }
+        workers->wait();
+
+        // Menggabungkan hasil menurut urutan tugas (= urutan baris) dan memasang teks baru
+        vector<Action::Replacement> allReplacements;
+        size_t changedLines = 0;
+        for (TaskResult& result : results) {
+            size_t replacement = allReplacements.size();
+            allReplacements.insert(allReplacements.end(), result.replacements.begin(), result.replacements.end());
+            for (LineEdit& edit : result.edits) {
+                Node* target = (edit.node != nullptr) ? edit.node : nodeAt(edit.linePos);
+                if (counting) {
+                    textStats -= TextStats::of(lineText(target));
+                    textStats += TextStats::of(edit.text);
+                }
+                editableText(target).assign(edit.text);
+                uint32_t anchor = anchorOf(target);
+                for (size_t i = 0; i < edit.replacements; i++) allReplacements[replacement++].anchor = anchor;
+                textChanged(target);
+                changedLines++;
+            }
+        }
+
+        if (!allReplacements.empty()) {
+            cout << "Mengganti " << allReplacements.size() << " kemunculan \"" << search << "\" dengan \""
+                 << replace << "\" di " << changedLines << " baris (" << taskCount << " tugas, "
+                 << workers->size() << " thread)." << endl;
+        }
+        if (!allReplacements.empty() && record) {
+            // Mencatat aksi REPLACE_TEXT ke undoStack dengan semua penggantian yang dilakukan
+            recordAction(Action(Action::REPLACE_TEXT, search, replace, allReplacements));
+            cout << "Penggantian teks selesai." << endl;
+        }
+        else if (record) {
+            cout << "Tidak ada kemunculan \"" << search << "\" ditemukan dalam teks." << endl;
+        }
+
+        display(); // Menampilkan teks setelah penggantian
+    }
+
+    // Fungsi untuk mengganti semua teks yang cocok dengan pola (daftar kata atau regex).
+    // Kecocokan dikumpulkan dulu dalam satu kali pindai, lalu setiap baris yang cocok
+    // ditulis ulang dari kiri ke kanan; teks lama setiap kecocokan ikut dicatat karena
+    // panjang dan isinya bisa berbeda-beda.
+    void replacePattern(const PatternSearch& pattern, const string& replace, bool record = true) {
+        Profiler::Scope scope(profiler, PROFILE_REPLACE_PATTERN);
+        struct PatternMatch {
+            int line;
+            int column;
+            int length;
+            Node* node; // nullptr untuk baris di dalam run berisi lebih dari satu baris
+        };
+        vector<PatternMatch> matches;
+        forEachMatch(pattern, [&](int line, int column, int length, Node* node) {
+            matches.push_back(PatternMatch{ line, column, length, node });
+        });
+
+        vector<Action::Replacement> allReplacements; // Menyimpan semua penggantian yang dilakukan
+        vector<int> oldLengths; // Panjang teks lama setiap penggantian
+        string oldTexts;        // Teks lama setiap penggantian, disambung berurutan
+        for (size_t i = 0; i < matches.size(); ) {
+            int linePos = matches[i].line;
+            Node* current = (matches[i].node != nullptr) ? matches[i].node : nodeAt(linePos);
+            LineText& text = editableText(current);
+            uint32_t anchor = anchorOf(current);
+            int shift = 0; // Selisih panjang akibat penggantian sebelumnya di baris ini
+            for (; i < matches.size() && matches[i].line == linePos; i++) {
+                int pos = matches[i].column + shift;
+                string oldText(text.data() + pos, matches[i].length);
+
+                Action::Replacement rep;
+                rep.anchor = anchor;
+                rep.charIdx = pos;
+                allReplacements.push_back(rep);
+                oldLengths.push_back(matches[i].length);
+                oldTexts += oldText;
+
+                countReplacement(current, pos, oldText, replace);
+                text.replace(pos, oldText.length(), replace);
+                cout << "Mengganti \"" << oldText << "\" dengan \"" << replace << "\" di baris " << linePos + 1 << ", posisi " << pos + 1 << "." << endl;
+                shift += (int)replace.length() - matches[i].length;
+            }
+            textChanged(current);
+        }
+
+        if (!allReplacements.empty() && record) {
+            // Mencatat aksi REPLACE_PATTERN ke undoStack beserta teks lama setiap penggantian
+            Action action(pattern.pattern(), replace, allReplacements, oldLengths, oldTexts);
+            journalAction(action, pattern.regex());
+            recordAction(action);
+            cout << "Penggantian teks selesai." << endl;
+        }
+        else if (record) {
+            cout << "Tidak ada teks yang cocok dengan pola \"" << pattern.pattern() << "\"." << endl;
+        }
+
+        display(); // Menampilkan teks setelah penggantian
+    }
+
+    // Fungsi untuk mengompilasi pola: regex, atau beberapa kata yang dipisah spasi
+    static bool compilePattern(bool regex, const string& text, PatternSearch& pattern, string& error) {
+        if (regex) return PatternSearch::compileRegex(text, pattern, error);
+        vector<string> words;
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t end = text.find(' ', start);
+            if (end == string::npos) end = text.size();
+            if (end > start) words.push_back(text.substr(start, end - start));
+            start = end + 1;
+        }
+        return PatternSearch::compileLiterals(words, pattern, error);
+    }
+
+    // Fungsi untuk membaca dan mengompilasi pola dari input pengguna
+    bool readPattern(PatternSearch& pattern) {
+        string kind;
+        string text;
+        cout << "Jenis pola (1 = beberapa kata dipisah spasi, 2 = regex): ";
+        getline(cin, kind);
+        cout << "Masukkan pola: ";
+        getline(cin, text);
+
+        string error;
+        bool compiled = compilePattern(kind == "2", text, pattern, error);
+        if (!compiled) {
+            cout << "Pola tidak valid: " << error << "." << endl;
+        }
+        return compiled;
+    }
+
+    // Fungsi untuk mencari pola secara interaktif
+    void searchPatternInteractive() {
+        PatternSearch pattern;
+        if (readPattern(pattern)) searchPatternAndHighlight(pattern);
+    }
+
+    // Fungsi untuk mengganti pola secara interaktif
+    void replacePatternInteractive() {
+        PatternSearch pattern;
+        if (!readPattern(pattern)) return;
+
+        string replaceTextInput;
+        cout << "Masukkan teks pengganti: ";
+        getline(cin, replaceTextInput);
+
+        replacePattern(pattern, replaceTextInput); // Mengganti semua teks yang cocok
+    }
+
+    // Fungsi untuk mengganti teks interaktif (mengambil input dari pengguna)
+    void replaceTextInteractive(bool parallel = false) {
+        string searchTextInput;
+        string replaceTextInput;
+
+        cout << "Masukkan teks yang ingin dicari: ";
+        getline(cin, searchTextInput);
+
+        if (searchTextInput.empty()) {
+            cout << "Teks pencarian tidak boleh kosong." << endl;
+            return;
+        }
+
+        cout << "Masukkan teks pengganti: ";
+        getline(cin, replaceTextInput);
+
+        if (parallel) {
+            replaceTextParallel(searchTextInput, replaceTextInput); // Memakai thread pool
+        }
+        else {
+            replaceText(searchTextInput, replaceTextInput); // Memanggil fungsi replaceText
+        }
+    }
+
+    // Fungsi untuk menambahkan satu baris ke Renderer. Baris currentNode diberi tanda
+    // kurung siku di sekitar karakter currentCharIndex, atau di sekitar seluruh baris
+    // jika tidak ada karakter yang di-highlight.
+    void addHighlightedRow(int linePos, string_view text, Node* current, bool listing) {
+        int markStart = -1;
+        int markLength = 0;
+        if (current != nullptr && current == currentNode) {
+            bool charHighlighted = currentCharIndex >= 0 && currentCharIndex < (int)text.length();
+            markStart = charHighlighted ? currentCharIndex : 0;
+            markLength = charHighlighted ? 1 : (int)text.length();
+            // Karakter UTF-8 multi-byte di-highlight utuh beserta byte lanjutannya
+            while (charHighlighted && markStart > 0 && CodepointIndex::isContinuation(text[markStart])) markStart--;
+            while (charHighlighted && markStart + markLength < (int)text.length()
+                   && CodepointIndex::isContinuation(text[markStart + markLength])) {
+                markLength++;
+            }
+        }
+        if (listing) renderer.addListingRow(linePos + 1, text, markStart, markLength);
+        else renderer.addRow(linePos + 1, text, markStart, markLength);
+    }
+
+    // Fungsi untuk menampilkan baris-baris di sekitar currentNode dengan highlighting pada
+    // currentCharIndex. Hanya baris di dalam viewport yang disusun; Renderer mengirim
+    // frame dengan satu kali write dan, di terminal, hanya menulis ulang baris yang berubah.
+    void display() {
+        Profiler::Scope scope(profiler, PROFILE_DISPLAY);
+        if (!rendering) return;
+        int lineCount = sizeOf(root);
+        int cursorLine = (currentNode != nullptr) ? indexOf(currentNode) : 0;
+        int first = renderer.scroll(cursorLine, lineCount);
+        renderer.beginFrame();
+        forEachLineInRange(first, renderer.viewportHeight(), [&](int linePos, string_view text, Node* current) {
+            addHighlightedRow(linePos, text, current, false);
+        });
+        renderer.endFrame(lineCount);
+    }
+
+    // Fungsi untuk menyalakan atau mematikan tampilan otomatis setelah setiap operasi
+    void setRendering(bool enabled) {
+        rendering = enabled;
+    }
+
+    // Fungsi untuk menggambar ulang viewport dari awal, misalnya setelah berpindah dari
+    // buffer lain yang juga menggambar di terminal
+    void redraw() {
+        renderer.invalidate();
+        display();
+    }
+
+    // Fungsi untuk menampilkan seluruh teks (bukan hanya viewport) dengan highlighting
+    // pada currentNode dan currentCharIndex
+    void displayAll() {
+        Profiler::Scope scope(profiler, PROFILE_DISPLAY_ALL);
+        renderer.beginListing();
+        forEachLine([&](int linePos, string_view text, Node* current) {
+            addHighlightedRow(linePos, text, current, true);
+        });
+        renderer.endListing();
+    }
+
+    // Fungsi untuk menampilkan statistik memori arena (dicadangkan vs. dipakai)
+    void displayMemoryStats() {
+        cout << "Arena node & teks  : " << arena.bytesInUse() << " byte dipakai dari "
+             << arena.bytesReserved() << " byte dicadangkan" << endl;
+        cout << "Riwayat undo/redo  : " << undoStack.bytesUsed() + redoStack.bytesUsed() + historyStrings->bytesUsed()
+             << " byte (catatan undo " << undoStack.bytesUsed() << ", catatan redo " << redoStack.bytesUsed()
+             << ", " << historyStrings->count() << " string internal " << historyStrings->bytesUsed()
+             << (historyStrings.use_count() > 1 ? " dipakai bersama" : "") << ")";
+        if (undoStack.byteBudget() != 0) {
+            cout << ", batas " << undoStack.byteBudget() << " byte, undo memakai "
+                 << undoStack.bytesUsed() + undoStack.stringBytesUsed() << " byte";
+        }
+        cout << endl;
+        if (historySpilled()) {
+            cout << "Riwayat di disk    : " << undoStack.bytesSpilled() + redoStack.bytesSpilled()
+                 << " byte (dibaca kembali saat undo/redo berikutnya)" << endl;
+        }
+        if (undoStack.evictedCount() > 0) {
+            cout << "Aksi tertua yang dibuang karena batas riwayat: " << undoStack.evictedCount() << endl;
+        }
+        if (index) {
+            cout << "Indeks trigram     : " << index->bytesUsed() << " byte (" << index->trigramCount()
+                 << " trigram, " << index->entryCount() << " entri, " << index->lineCount() << " baris, "
+                 << index->staleKeyCount() << " kunci usang)" << endl;
+        }
+        else {
+            cout << "Indeks trigram     : nonaktif" << endl;
+        }
+        if (versioning) {
+            cout << "Snapshot dokumen   : aktif (versi " << versions.version() << ", " << versions.lineCount()
+                 << " baris)" << endl;
+        }
+        else {
+            cout << "Snapshot dokumen   : belum dipakai" << endl;
+        }
+        cout << "Statistik teks     : " << (counting ? "aktif (diperbarui setiap edit)" : "belum dipakai") << endl;
+        if (columnNode != nullptr) {
+            cout << "Indeks kolom       : baris " << indexOf(columnNode) + 1 << ", " << columnIndex.sampleCount()
+                 << " sampel (setiap " << CodepointIndex::STRIDE << " codepoint)" << endl;
+        }
+        else {
+            cout << "Indeks kolom       : belum dipakai" << endl;
+        }
+        cout << "Jangkar riwayat    : " << anchors.size() - 1 << " baris (" << anchors.capacity() * sizeof(Node*) << " byte)" << endl;
+        if (journal.isOpen()) {
+            cout << "Jurnal pemulihan   : \"" << journal.filePath() << "\", " << journal.records() << " catatan, "
+                 << journal.position() << " byte, " << journal.commits() << " fsync" << endl;
+        }
+        else {
+            cout << "Jurnal pemulihan   : nonaktif" << endl;
+        }
+        cout << "Jumlah baris: " << sizeOf(root) << ", aksi undo: " << undoStack.size()
+             << ", aksi redo: " << redoStack.size() << endl;
+    }
+
+    // Fungsi untuk mengatur batas memori riwayat undo secara interaktif. Jika batas
+    // terlampaui, aksi tertua dibuang sampai pemakaian kembali di bawah batas.
+    void setHistoryBudgetInteractive() {
+        long long kilobytes;
+        cout << "Masukkan batas memori riwayat undo dalam KB (0 = tanpa batas): ";
+        cin >> kilobytes;
+        cin.ignore(); // Membersihkan newline dari buffer
+        if (kilobytes < 0) {
+            cout << "Batas tidak boleh negatif." << endl;
+            return;
+        }
+        size_t dropped = setHistoryBudget((size_t)kilobytes * 1024);
+        if (kilobytes == 0) {
+            cout << "Riwayat undo tidak dibatasi." << endl;
+        }
+        else {
+            cout << "Riwayat undo dibatasi " << kilobytes << " KB; " << dropped << " aksi tertua dibuang." << endl;
+        }
+    }
+
+    // Fungsi untuk mengatur batas memori riwayat undo dalam byte (0 = tanpa batas);
+    // mengembalikan jumlah aksi tertua yang dibuang karenanya
+    size_t setHistoryBudget(size_t bytesLimit) {
+        size_t before = undoStack.evictedCount();
+        undoStack.setBudget(bytesLimit);
+        journalControl(JOURNAL_BUDGET, (uint64_t)bytesLimit); // Replay membuang aksi yang sama
+        return undoStack.evictedCount() - before;
+    }
+
+    size_t getHistoryBudget() const {
+        return undoStack.byteBudget();
+    }
+
+    size_t getHistoryEvicted() const {
+        return undoStack.evictedCount();
+    }
+
+    // Fungsi untuk mengambil snapshot dokumen dalam O(1) (snapshot pertama membangun
+    // salinan persisten sekali dalam O(jumlah node)). Snapshot boleh dibaca dari thread
+    // lain tanpa kunci selama dokumen terus diedit di thread ini.
+    DocumentSnapshot snapshot() {
+        Profiler::Scope scope(profiler, PROFILE_SAVE_SNAPSHOT);
+        flushGap();
+        if (!versioning) buildVersions();
+        return versions.snapshot();
+    }
+
+    // Fungsi untuk mengubah snapshot dokumen menjadi potongan byte yang akan disimpan
+    // (dijalankan di thread penyimpan). Baris milik node disalin; baris file yang
+    // belum diedit cukup dicatat sebagai rentang byte di pemetaan file, yang dijaga
+    // tetap hidup oleh snapshot walaupun file lain dibuka.
+    static BackgroundSaver::Snapshot saveSnapshot(const DocumentSnapshot& document) {
+        BackgroundSaver::Snapshot result;
+        const shared_ptr<const MappedFile>& file = document.sourceFile();
+        if (file) {
+            result.externalData = file->data();
+            result.keepAlive = file;
+        }
+        document.forEachNode([&](const DocumentVersions::Node& node) {
+            if (node.runCount == 0) {
+                result.addText(node.text->data(), node.text->size());
+                result.addText("\n", 1);
+                return;
+            }
+            // Byte file disalin apa adanya (termasuk '\r\n'); baris terakhir file yang
+            // tidak diakhiri newline diberi '\n'
+            size_t begin = file->lineStart(node.sourceLine);
+            size_t end = file->lineStart(node.sourceLine + node.runCount);
+            result.add(true, begin, end - begin);
+            if (file->data()[end - 1] != '\n') result.addText("\n", 1);
+        });
+        return result;
+    }
+
+    // Fungsi untuk menyimpan dokumen ke path di thread terpisah. Hanya pengambilan
+    // snapshot yang berjalan di thread ini; pengeditan bisa langsung berlanjut.
+    bool save(const string& path) {
+        if (saver.busy()) {
+            cout << "Penyimpanan sebelumnya masih berjalan." << endl;
+            return false;
+        }
+        auto start = chrono::steady_clock::now();
+        DocumentSnapshot document = snapshot();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        savedJournalEvents = journalEvents;
+        savedJournalPosition = journal.position();
+        saver.startPrepared(path, [document]() { return saveSnapshot(document); });
+        documentPath = path;
+        cout << "Menyimpan " << document.lineCount() << " baris ke \"" << path
+             << "\" di latar belakang; snapshot diambil dalam " << (long long)elapsed.count() << " ms." << endl;
+        return true;
+    }
+
+    // Fungsi untuk menyimpan dokumen dengan path dari input pengguna (Enter = path
+    // file yang terakhir dibuka atau disimpan)
+    void saveInteractive() {
+        string path;
+        cout << "Masukkan path file tujuan";
+        if (!documentPath.empty()) cout << " (Enter = \"" << documentPath << "\")";
+        cout << ": ";
+        getline(cin, path);
+        if (path.empty()) path = documentPath;
+        if (path.empty()) {
+            cout << "Path file tidak boleh kosong." << endl;
+            return;
+        }
+        save(path);
+    }
+
+    // Fungsi untuk mengambil hasil penyimpanan latar belakang dan melaporkannya ke out.
+    // Jika wait bernilai true, penyimpanan yang masih berjalan ditunggu sampai selesai.
+    // Mengembalikan false hanya jika ada penyimpanan yang gagal.
+    bool finishSave(bool wait, ostream& out) {
+        BackgroundSaver::Result result;
+        if (!(wait ? saver.wait(result) : saver.poll(result))) return true;
+        if (!result.ok) {
+            out << "Gagal menyimpan: " << result.error << "." << endl;
+            return false;
+        }
+        double megabytes = result.bytes / (1024.0 * 1024.0);
+        double seconds = result.milliseconds / 1000.0;
+        ios_base::fmtflags flags = out.flags();
+        streamsize precision = out.precision();
+        out << "File \"" << result.path << "\" disimpan: " << result.bytes << " byte dalam " << fixed
+            << setprecision(1) << result.milliseconds << " ms (" << (seconds > 0.0 ? megabytes / seconds : 0.0)
+            << " MB/s, " << result.pieces << " potongan)." << endl;
+        out.flags(flags);
+        out.precision(precision);
+
+        // Jurnal kini cukup memuat aksi setelah snapshot, di atas file yang baru disimpan.
+        // Dokumen tanpa jurnal hanya mendapat jurnal jika belum diedit sejak snapshot.
+        Journal::FileIdentity identity;
+        if (journaling && (journal.isOpen() || journalEvents == savedJournalEvents) &&
+            Journal::identify(result.path, identity) &&
+            !journal.rebase(result.path + ".journal", identity, savedJournalPosition)) {
+            out << "Jurnal \"" << result.path << ".journal\" tidak bisa diperbarui; perubahan berikutnya tidak terlindungi dari crash." << endl;
+        }
+        return true;
+    }
+
+    // Fungsi untuk menulis catatan jurnal yang masih di buffer ke disk (dipanggil
+    // sebelum menunggu input agar aksi yang sudah tampil tidak hilang saat crash)
+    void syncJournal() {
+        journal.commit();
+    }
+
+    // Fungsi untuk menutup jurnal pada akhir sesi normal; jurnal tidak dibutuhkan lagi
+    void closeJournal() {
+        journal.close(true);
+    }
+
+    // Fungsi untuk mengaktifkan atau menonaktifkan jurnal untuk file yang dibuka berikutnya
+    void setJournaling(bool enabled) {
+        journaling = enabled;
+        if (!enabled) closeJournal();
+    }
+
+    // Fungsi untuk mengaktifkan atau menonaktifkan profiler operasi
+    void setProfiling(bool enabled) {
+        profiler.setEnabled(enabled);
+    }
+
+    bool isProfiling() const {
+        return profiler.isEnabled();
+    }
+
+    // Fungsi untuk menulis laporan profiler (operasi dengan waktu total terbesar di atas)
+    void reportProfile(ostream& out) const {
+        out << "\n=== Profil Operasi ===\n";
+        profiler.report(out);
+    }
+
+    // Fungsi untuk profiler dari menu: pertama kali mengaktifkan, berikutnya
+    // menampilkan laporan lalu menawarkan reset atau menonaktifkan
+    void profileInteractive() {
+        if (!profiler.isEnabled()) {
+            profiler.setEnabled(true);
+            cout << "Profiler diaktifkan. Pilih opsi ini lagi untuk melihat laporan." << endl;
+            return;
+        }
+        reportProfile(cout);
+        string answer;
+        cout << "Ketik r untuk reset, n untuk menonaktifkan, atau Enter untuk kembali: ";
+        getline(cin, answer);
+        if (answer == "r") {
+            profiler.reset();
+            cout << "Statistik profiler dikosongkan." << endl;
+        }
+        else if (answer == "n") {
+            profiler.setEnabled(false);
+            cout << "Profiler dinonaktifkan." << endl;
+        }
+    }
+
+    // Fungsi untuk mengaktifkan atau menonaktifkan indeks trigram pencarian. Selama aktif,
+    // indeks diperbarui setiap kali sebuah baris disisipkan, dihapus, atau teksnya berubah,
+    // sehingga pencarian kata kunci (minimal 3 byte) hanya memeriksa baris kandidat.
+    void toggleSearchIndex() {
+        if (index) {
+            index.reset();
+            cout << "Indeks pencarian dinonaktifkan." << endl;
+            return;
+        }
+        auto start = chrono::steady_clock::now();
+        buildSearchIndex();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        cout << "Indeks pencarian aktif: " << index->lineCount() << " baris diindeks dalam "
+             << (long long)elapsed.count() << " ms, memakai " << index->bytesUsed() << " byte." << endl;
+    }
+
+    // Fungsi untuk memulai transaksi. Semua aksi yang dicatat sampai commitTransaction
+    // menjadi satu grup undo; transaksi boleh bersarang dan grup ditutup oleh commit
+    // yang terluar. Selama transaksi berjalan, undo dan redo tidak bisa dipakai, dan batas
+    // riwayat ditunda sampai commit agar grupnya bisa dibuang utuh.
+    void beginTransaction() {
+        journalControl(JOURNAL_BEGIN);
+        if (transactionDepth++ == 0) {
+            undoStack.holdBudget();
+            transactionActions = 0;
+            coalesceCount = 0; // Edit karakter di dalam transaksi tidak digabung terpisah
+        }
+    }
+
+    // Fungsi untuk menyelesaikan transaksi; mengembalikan jumlah aksi di dalam grupnya
+    int commitTransaction() {
+        if (transactionDepth == 0) return 0;
+        journalControl(JOURNAL_COMMIT);
+        if (--transactionDepth > 0) return transactionActions;
+        // Satu aksi saja tidak perlu penanda grup
+        if (transactionActions > 1) undoStack.push(Action(Action::GROUP, transactionActions));
+        undoStack.releaseBudget();
+        return transactionActions;
+    }
+
+    bool inTransaction() const {
+        return transactionDepth > 0;
+    }
+
+    // Fungsi untuk memulai atau menyelesaikan transaksi dari menu
+    void toggleTransaction() {
+        if (!inTransaction()) {
+            beginTransaction();
+            cout << "Transaksi dimulai: aksi berikutnya akan di-undo sekaligus." << endl;
+            return;
+        }
+        int actions = commitTransaction();
+        cout << "Transaksi selesai: " << actions << " aksi dicatat sebagai satu grup undo." << endl;
+    }
+
+    // Fungsi untuk menyisipkan baris dan mencatat aksi
+    void insertAndTrack(int position, string_view data) {
+        insertLine(position, data, true);
+    }
+
+    // Fungsi untuk menampilkan seluruh teks dengan kecocokan pertama di setiap baris
+    // disorot. description dipakai pada pesan jika tidak ada yang ditemukan.
+    template <typename Searcher>
+    void highlightMatches(const Searcher& search, const string& description) {
+        Profiler::Scope scope(profiler, PROFILE_SEARCH);
+        bool found = false;
+        int lineCount = sizeOf(root);
+        bool matchEmpty = search.pattern().empty(); // Kata kunci kosong cocok di awal baris
+
+        // Kumpulkan kecocokan pertama di setiap baris dengan mesin pencarian, lalu
+        // tampilkan seluruh baris sambil mencocokkannya secara berurutan
+        struct LineMatch {
+            int line;
+            int column;
+            int length;
+        };
+        vector<LineMatch> firstMatches;
+        forEachMatch(search, [&](int lineIndex, int column, int length, Node*) {
+            if (firstMatches.empty() || firstMatches.back().line != lineIndex) {
+                firstMatches.push_back(LineMatch{ lineIndex, column, length });
+            }
+        });
+        size_t nextMatch = 0;
+
+        forEachLine([&](int lineIndex, string_view text, Node*) {
+            int linePos = lineIndex + 1;
+            size_t pos = matchEmpty ? 0 : string::npos;
+            size_t length = 0;
+            if (nextMatch < firstMatches.size() && firstMatches[nextMatch].line == lineIndex) {
+                pos = firstMatches[nextMatch].column;
+                length = firstMatches[nextMatch].length;
+                nextMatch++;
+            }
+            if (pos != string::npos) {
+                found = true;
+                string highlighted(text);
+                // Menambahkan tanda kurung siku di sekitar teks yang ditemukan
+                highlighted.insert(pos + length, "]");
+                highlighted.insert(pos, "[");
+                cout << linePos << ": " << highlighted;
+            }
+            else {
+                cout << linePos << ": " << text;
+            }
+            if (linePos < lineCount) cout << "\n";
+        });
+        if (!found) {
+            cout << "\n" << description << " tidak ditemukan." << endl;
+        }
+        else {
+            cout << endl;
+        }
+    }
+
+    // Fungsi untuk mencari dan menyorot kata kunci dalam teks
+    void searchAndHighlight(const string& keyword) {
+        highlightMatches(SubstringSearch(keyword), "Kata kunci \"" + keyword + "\"");
+    }
+
+    // Fungsi untuk mencari dan menyorot pola (daftar kata atau regex) dalam teks
+    void searchPatternAndHighlight(const PatternSearch& pattern) {
+        highlightMatches(pattern, "Pola \"" + pattern.pattern() + "\"");
+    }
+
+    // Fungsi untuk navigasi ke baris berikutnya
+    void moveToNextLine() {
+        Profiler::Scope scope(profiler, PROFILE_NEXT_LINE);
+        if (currentNode == nullptr) {
+            cout << "Tidak ada baris untuk dinavigasi." << endl;
+            return;
+        }
+
+        if (currentNode->next != nullptr) {
+            currentNode = nextLine(currentNode); // Pindah ke baris berikutnya
+            currentCharIndex = 0;               // Reset indeks karakter ke awal
+            cout << "Berpindah ke baris berikutnya." << endl;
+        }
+        else {
+            cout << "Sudah berada di baris terakhir." << endl;
+        }
+    }
+
+    // Fungsi untuk navigasi ke baris sebelumnya
+    void moveToPrevLine() {
+        Profiler::Scope scope(profiler, PROFILE_PREV_LINE);
+        if (currentNode == nullptr) {
+            cout << "Tidak ada baris untuk dinavigasi." << endl;
+            return;
+        }
+
+        if (currentNode->prev != nullptr) {
+            currentNode = prevLine(currentNode); // Pindah ke baris sebelumnya
+            currentCharIndex = 0;               // Reset indeks karakter ke awal
+            cout << "Berpindah ke baris sebelumnya." << endl;
+        }
+        else {
+            cout << "Sudah berada di baris pertama." << endl;
+        }
+    }
+
+    // Fungsi untuk navigasi ke karakter berikutnya dalam baris saat ini. Kursor melompati
+    // satu karakter UTF-8 utuh; hanya byte karakter itu yang dibaca, jadi O(1) berapa pun
+    // panjang barisnya.
+    void moveToNextChar() {
+        Profiler::Scope scope(profiler, PROFILE_NEXT_CHAR);
+        if (currentNode == nullptr) {
+            cout << "Tidak ada baris tersedia." << endl;
+            return;
+        }
+
+        size_t length = lineLength(currentNode);
+        size_t next = length;
+        if (currentCharIndex >= 0 && currentCharIndex < (int)length) {
+            size_t start = charStart(currentNode, currentCharIndex);
+            next = start + charLength(currentNode, start);
+        }
+        if (next < length) {
+            currentCharIndex = (int)next; // Pindah ke karakter berikutnya
+            cout << "Berpindah ke karakter berikutnya." << endl;
+        }
+        else {
+            cout << "Sudah berada di karakter terakhir dari baris saat ini." << endl;
+        }
+    }
+
+    // Fungsi untuk navigasi ke karakter sebelumnya dalam baris saat ini, mundur satu
+    // karakter UTF-8 utuh
+    void moveToPrevChar() {
+        Profiler::Scope scope(profiler, PROFILE_PREV_CHAR);
+        if (currentNode == nullptr) {
+            cout << "Tidak ada baris tersedia." << endl;
+            return;
+        }
+
+        size_t index = min((size_t)max(currentCharIndex, 0), lineLength(currentNode));
+        size_t start = (index > 0) ? charStart(currentNode, index) : 0;
+        if (start > 0) {
+            currentCharIndex = (int)charStart(currentNode, start - 1); // Pindah ke karakter sebelumnya
+            cout << "Berpindah ke karakter sebelumnya." << endl;
+        }
+        else {
+            cout << "Sudah berada di karakter pertama dari baris saat ini." << endl;
+        }
+    }
+
+    // Fungsi untuk memindahkan kursor ke awal baris nomor line (dimulai dari 1) dalam
+    // O(log n); baris di dalam run file dibaca lewat checkpoint tanpa menelusuri dokumen
+    bool jumpToLine(int line) {
+        Profiler::Scope scope(profiler, PROFILE_JUMP);
+        if (line < 1 || line > sizeOf(root)) {
+            cout << "Nomor baris harus antara 1 dan " << sizeOf(root) << "." << endl;
+            return false;
+        }
+        currentNode = nodeAt(line - 1);
+        currentCharIndex = 0;
+        cout << "Berpindah ke baris " << line << "." << endl;
+        return true;
+    }
+
+    // Fungsi untuk memindahkan kursor ke byte ke-offset (dimulai dari 0) dokumen dalam
+    // bentuk tersimpan. Kursor berada di baris yang memuat offset; offset yang jatuh pada
+    // newline ditempatkan di karakter terakhir baris itu.
+    bool jumpToOffset(size_t offset) {
+        Profiler::Scope scope(profiler, PROFILE_JUMP);
+        flushGap(); // Jumlah byte leluhur baris di gap buffer baru diperbarui di sini
+        if (offset >= bytesOf(root)) {
+            cout << "Offset harus kurang dari " << bytesOf(root) << " byte." << endl;
+            return false;
+        }
+        int position = positionAtOffset(offset);
+        currentNode = nodeAt(position);
+        size_t column = offset - offsetOf(currentNode);
+        size_t length = lineText(currentNode).length();
+        currentCharIndex = (int)charStart(currentNode, min(column, length > 0 ? length - 1 : 0));
+        cout << "Berpindah ke baris " << position + 1 << ", kolom " << columnAt(currentNode, currentCharIndex) + 1 << "." << endl;
+        return true;
+    }
+
+    // Fungsi untuk memindahkan kursor ke kolom column (dimulai dari 1, dihitung dalam
+    // codepoint UTF-8) pada baris saat ini. Baris panjang memakai indeks kolom, jadi
+    // lompatan tidak memindai baris dari awal.
+    bool jumpToColumn(size_t column) {
+        Profiler::Scope scope(profiler, PROFILE_JUMP);
+        if (currentNode == nullptr) {
+            cout << "Dokumen kosong." << endl;
+            return false;
+        }
+        size_t length = lineLength(currentNode);
+        size_t index = (column > 0) ? byteAtColumn(currentNode, column - 1) : length;
+        if (index >= length && !(column == 1 && length == 0)) {
+            cout << "Kolom harus antara 1 dan " << max<size_t>(columnAt(currentNode, length), 1) << "." << endl;
+            return false;
+        }
+        currentCharIndex = (int)index;
+        cout << "Berpindah ke kolom " << column << "." << endl;
+        return true;
+    }
+
+    // Struktur hasil statistik dokumen, dihitung seperti wc pada file yang disimpan
+    struct DocumentStats {
+        size_t lines;
+        size_t words;
+        size_t bytes;      // Ukuran dokumen saat disimpan, termasuk akhir baris
+        size_t codepoints; // Codepoint UTF-8, termasuk akhir baris
+    };
+
+    // Fungsi untuk mendapatkan statistik dokumen. Permintaan pertama menelusuri dokumen
+    // sekali; sesudahnya hasilnya diambil dari total yang diperbarui setiap edit, O(1).
+    DocumentStats documentStats() {
+        if (!counting) buildTextStats();
+        size_t bytes = bytesOf(root);
+        if (gapNode != nullptr) bytes = bytes - gapNode->data.size() + activeLine.length(); // Rope belum melihat isi gap buffer
+        // Byte yang tidak tercatat di textStats adalah akhir baris ('\n' atau '\r\n'), satu codepoint per byte
+        size_t lineEnds = bytes - (size_t)textStats.bytes;
+        return DocumentStats{ (size_t)sizeOf(root), (size_t)textStats.words, bytes, (size_t)textStats.codepoints + lineEnds };
+    }
+
+    // Fungsi untuk menulis statistik dokumen (baris, kata, byte, codepoint) ke out
+    void printTextStats(ostream& out) {
+        DocumentStats stats = documentStats();
+        out << "Baris: " << stats.lines << ", kata: " << stats.words << ", byte: " << stats.bytes
+            << ", karakter (codepoint UTF-8): " << stats.codepoints << endl;
+    }
+
+    // Fungsi untuk menulis posisi kursor (baris, kolom dalam codepoint, offset byte) ke out
+    void printPosition(ostream& out) {
+        if (currentNode == nullptr) {
+            out << "Dokumen kosong." << endl;
+            return;
+        }
+        // Gap buffer tidak dikembalikan ke node agar edit berikutnya tidak menyalin ulang
+        // baris panjang; selisih panjangnya dikoreksi seperti di documentStats
+        int line = indexOf(currentNode);
+        size_t offset = offsetOf(currentNode);
+        size_t total = bytesOf(root);
+        if (gapNode != nullptr) {
+            size_t stale = gapNode->data.size();
+            total = total - stale + activeLine.length();
+            if (indexOf(gapNode) < line) offset = offset - stale + activeLine.length();
+        }
+        out << "Baris " << line + 1 << " dari " << sizeOf(root)
+            << ", kolom " << columnAt(currentNode, max(currentCharIndex, 0)) + 1
+            << ", offset " << offset + currentCharIndex << " dari " << total << " byte" << endl;
+    }
+
+    // Fungsi untuk meminta nomor baris, offset byte (diawali '@'), atau kolom di baris
+    // saat ini (diawali ':') lalu melompat ke sana
+    void jumpInteractive() {
+        printPosition(cout);
+        if (currentNode == nullptr) return;
+        string input;
+        cout << "Masukkan nomor baris, @offset untuk offset byte, atau :kolom untuk kolom di baris ini: ";
+        getline(cin, input);
+        bool byOffset = !input.empty() && input[0] == '@';
+        bool byColumn = !input.empty() && input[0] == ':';
+        string digits = (byOffset || byColumn) ? input.substr(1) : input;
+        char* end = nullptr;
+        errno = 0;
+        unsigned long long value = strtoull(digits.c_str(), &end, 10);
+        if (digits.empty() || !isdigit((unsigned char)digits[0]) || *end != '\0' || errno != 0) {
+            cout << "Masukan tidak valid." << endl;
+            return;
+        }
+        bool moved = byOffset ? jumpToOffset((size_t)value)
+                   : byColumn ? jumpToColumn((size_t)value)
+                   : jumpToLine(value > (unsigned long long)INT_MAX ? 0 : (int)value);
+        if (moved) display();
+    }
+
+    // Fungsi untuk menghapus seluruh baris yang sedang di-highlight
+    void deleteCurrentLine() {
+        if (currentNode == nullptr) {
+            cout << "Tidak ada baris yang dapat dihapus." << endl;
+            return;
+        }
+
+        int pos = getCurrentLinePosition(); // Mendapatkan posisi baris saat ini
+        if (pos == -1) {
+            cout << "Kesalahan dalam mendapatkan posisi baris." << endl;
+            return;
+        }
+
+        // Menghapus currentNode tanpa mencatat ulang aksi, lalu mencatat aksi DELETE_LINE
+        // (beserta data dan jangkar barisnya) ke undoStack
+        Action action(Action::DELETE_LINE, pos, lineText(currentNode));
+        action.anchor = deleteLine(pos, false);
+        recordAction(action);
+        cout << "Baris telah dihapus." << endl;
+
+        display(); // Menampilkan teks setelah penghapusan
+    }
+
+    // Fungsi untuk membatalkan satu aksi (bukan GROUP) lalu memindahkannya ke redoStack.
+    // Mengembalikan false jika aksi tidak bisa diterapkan pada teks saat ini; report
+    // menentukan apakah pesan untuk aksi ini ditampilkan.
+    bool undoAction(const Action& lastAction, bool report) {
+        Profiler::Scope scope(profiler, PROFILE_UNDO_ACTION + lastAction.type);
+        size_t before = redoStack.size();
+
+        switch (lastAction.type) {
+            case Action::INSERT_LINE: {
+                // Undo INSERT_LINE dengan menghapus baris yang di-insert; jangkar yang
+                // sempat didapat baris itu disimpan agar redo bisa memasangnya lagi
+                Action redone = lastAction;
+                redone.anchor = deleteLine(lastAction.linePosition, false);
+                journalAction(Action(Action::DELETE_LINE, lastAction.linePosition, string_view()));
+                // Menambahkan aksi ke redoStack untuk memungkinkan redo
+                redoStack.push(redone);
+                if (report) cout << "Undo: Menghapus baris yang di-insert." << endl;
+                break;
+            }
+
+            case Action::DELETE_LINE:
+                // Undo DELETE_LINE dengan menyisipkan kembali baris yang dihapus beserta jangkarnya
+                bindAnchor(insertLine(lastAction.linePosition, lastAction.data, false), lastAction.anchor);
+                journalAction(Action(Action::INSERT_LINE, lastAction.linePosition, lastAction.data));
+                // Menambahkan aksi ke redoStack untuk memungkinkan redo
+                redoStack.push(lastAction);
+                if (report) cout << "Undo: Menyisipkan kembali baris yang dihapus." << endl;
+                break;
+
+            case Action::INSERT_CHAR: {
+                // Undo INSERT_CHAR dengan menghapus karakter yang disisipkan
+                Node* targetNode = anchoredNode(lastAction.anchor); // Jangkar baris -> node dalam O(1)
+                if (targetNode != nullptr) {
+                    if (lastAction.charIndex >= 0 && lastAction.charIndex < (int)lineLength(targetNode)) {
+                        eraseChar(targetNode, lastAction.charIndex);
+                        journalAction(Action(Action::DELETE_CHAR, indexOf(targetNode), lastAction.charIndex));
+                        // Menambahkan aksi ke redoStack
+                        redoStack.push(lastAction);
+                        if (report) cout << "Undo: Menghapus karakter yang disisipkan." << endl;
+                    }
+                }
+                break;
+            }
+
+            case Action::DELETE_CHAR: {
+                // Undo DELETE_CHAR dengan menyisipkan kembali karakter yang dihapus
+                Node* targetNode = anchoredNode(lastAction.anchor); // Jangkar baris -> node dalam O(1)
+                if (targetNode != nullptr) {
+                    if (lastAction.charIndex >= 0 && lastAction.charIndex <= (int)lineLength(targetNode)) {
+                        // Menyisipkan kembali karakter yang dihapus
+                        insertChar(targetNode, lastAction.charIndex, lastAction.oldChar);
+                        journalAction(Action(Action::INSERT_CHAR, indexOf(targetNode), lastAction.charIndex, '\0', lastAction.oldChar));
+                        // Menambahkan aksi ke redoStack
+                        redoStack.push(lastAction);
+                        if (report) cout << "Undo: Menyisipkan kembali karakter yang dihapus." << endl;
+                    }
+                }
+                break;
+            }
+
+            case Action::REPLACE_CHAR: {
+                // Undo REPLACE_CHAR dengan mengganti kembali karakter ke oldChar
+                Node* targetNode = anchoredNode(lastAction.anchor); // Jangkar baris -> node dalam O(1)
+                if (targetNode != nullptr) {
+                    if (lastAction.charIndex >= 0 && lastAction.charIndex < (int)lineLength(targetNode)) {
+                        // Mengganti karakter kembali ke karakter lama
+                        setChar(targetNode, lastAction.charIndex, lastAction.oldChar);
+                        journalAction(Action(Action::REPLACE_CHAR, indexOf(targetNode), lastAction.charIndex, lastAction.newChar, lastAction.oldChar));
+                        // Menambahkan aksi ke redoStack
+                        redoStack.push(lastAction);
+                        if (report) cout << "Undo: Mengganti karakter kembali ke '" << lastAction.oldChar << "'." << endl;
+                    }
+                }
+                break;
+            }
+
+            case Action::REPLACE_TEXT: {
+                // Undo REPLACE_TEXT dengan mengganti kembali semua penggantian
+                string_view oldText = lastAction.searchText;
+                string_view newText = lastAction.replaceWithText;
+                const Action::Replacement* reps = lastAction.replacements.data();
+                Node* changed = nullptr; // Baris yang sedang diubah; textChanged sekali per baris
+                int changedLine = -1;    // Posisi baris changed (untuk jurnal)
+                for (size_t i = lastAction.replacementCount(); i-- > 0; ) {
+                    const Action::Replacement* it = &reps[i];
+                    Node* targetNode = anchoredNode(it->anchor); // Jangkar baris -> node dalam O(1)
+                    if (targetNode != nullptr) {
+                        if (it->charIdx >= 0 && it->charIdx + newText.length() <= lineText(targetNode).length()) {
+                            if (targetNode != changed) {
+                                if (changed != nullptr) textChanged(changed);
+                                changed = targetNode;
+                                changedLine = indexOf(targetNode);
+                            }
+                            journalSplice(changedLine, it->charIdx, newText.length(), oldText);
+                            // Mengganti kembali teks ke teks lama
+                            countReplacement(targetNode, it->charIdx, newText, oldText);
+                            editableText(targetNode).replace(it->charIdx, newText.length(), oldText);
+                        }
+                    }
+                }
+                if (changed != nullptr) textChanged(changed);
+                // Menambahkan aksi ke redoStack
+                redoStack.push(lastAction);
+                if (report) cout << "Undo: Mengganti kembali teks yang telah diubah." << endl;
+                break;
+            }
+
+            case Action::REPLACE_PATTERN: {
+                // Undo REPLACE_PATTERN dengan memasang kembali teks lama setiap penggantian
+                string_view newText = lastAction.replaceWithText;
+                const Action::Replacement* reps = lastAction.replacements.data();
+                const int* lengths = lastAction.oldLengths.data();
+                const char* oldTexts = lastAction.oldTexts.data();
+                size_t count = lastAction.replacementCount();
+                vector<size_t> offsets(count); // Offset teks lama setiap penggantian
+                size_t total = 0;
+                for (size_t i = 0; i < count; i++) {
+                    offsets[i] = total;
+                    total += lengths[i];
+                }
+                Node* changed = nullptr; // Baris yang sedang diubah; textChanged sekali per baris
+                int changedLine = -1;    // Posisi baris changed (untuk jurnal)
+                for (size_t i = count; i-- > 0; ) {
+                    Node* targetNode = anchoredNode(reps[i].anchor);
+                    if (targetNode != nullptr) {
+                        if (reps[i].charIdx >= 0 && reps[i].charIdx + newText.length() <= lineText(targetNode).length()) {
+                            if (targetNode != changed) {
+                                if (changed != nullptr) textChanged(changed);
+                                changed = targetNode;
+                                changedLine = indexOf(targetNode);
+                            }
+                            journalSplice(changedLine, reps[i].charIdx, newText.length(), string_view(oldTexts + offsets[i], lengths[i]));
+                            countReplacement(targetNode, reps[i].charIdx, newText, string_view(oldTexts + offsets[i], lengths[i]));
+                            editableText(targetNode).replace(reps[i].charIdx, newText.length(), oldTexts + offsets[i], lengths[i]);
+                        }
+                    }
+                }
+                if (changed != nullptr) textChanged(changed);
+                // Menambahkan aksi ke redoStack
+                redoStack.push(lastAction);
+                if (report) cout << "Undo: Mengganti kembali teks yang telah diubah." << endl;
+                break;
+            }
+
+            default:
+                cout << "Aksi tidak dikenali." << endl;
+                break;
+        }
+        return redoStack.size() > before;
+    }
+
+    // Fungsi untuk melakukan undo terhadap aksi terakhir
+    void undo() {
+        Profiler::Scope scope(profiler, PROFILE_UNDO);
+        if (transactionDepth > 0) {
+            cout << "Selesaikan transaksi terlebih dahulu sebelum undo." << endl;
+            return;
+        }
+        if (undoStack.empty()) {
+            cout << "Tidak ada aksi untuk di-undo." << endl;
+            if (undoStack.evictedCount() > 0) {
+                cout << "Riwayat dipangkas: " << undoStack.evictedCount()
+                     << " aksi tertua sudah dibuang karena batas riwayat." << endl;
+            }
+            return;
+        }
+
+        Action lastAction = undoStack.top(); // Mengambil aksi terakhir dari undoStack
+        undoStack.pop();                      // Menghapus aksi dari undoStack
+        journalControl(JOURNAL_BEGIN);        // Edit yang diterapkan dicatat sebagai satu grup
+        coalesceCount = 0;                    // Edit karakter berikutnya memulai grup baru
+
+        if (lastAction.type == Action::GROUP) {
+            // Undo GROUP dengan membatalkan anggotanya dari yang terbaru. Anggota masuk ke
+            // redoStack satu per satu, lalu ditutup penanda grup agar redo juga sekaligus.
+            int undone = 0;
+            for (int i = 0; i < lastAction.groupSize && !undoStack.empty(); i++) {
+                Action member = undoStack.top();
+                undoStack.pop();
+                if (undoAction(member, false)) undone++;
+            }
+            if (undone > 0) redoStack.push(Action(Action::GROUP, undone));
+            cout << "Undo: Membatalkan " << undone << " aksi dalam satu grup." << endl;
+        }
+        else {
+            undoAction(lastAction, true);
+        }
+        journalControl(JOURNAL_COMMIT);
+
+        display(); // Menampilkan teks setelah undo
+    }
+
+    // Fungsi untuk mengulangi satu aksi (bukan GROUP) lalu memindahkannya ke undoStack.
+    // Mengembalikan false jika aksi tidak bisa diterapkan pada teks saat ini; report
+    // menentukan apakah pesan untuk aksi ini ditampilkan.
+    bool redoAction(const Action& lastAction, bool report) {
+        Profiler::Scope scope(profiler, PROFILE_REDO_ACTION + lastAction.type);
+        size_t before = undoStack.size();
+
+        switch (lastAction.type) {
+            case Action::INSERT_LINE:
+                // Redo INSERT_LINE dengan menyisipkan kembali baris beserta jangkarnya
+                bindAnchor(insertLine(lastAction.linePosition, lastAction.data, false), lastAction.anchor);
+                journalAction(lastAction);
+                // Menambahkan aksi ke undoStack untuk memungkinkan undo
+                undoStack.push(lastAction);
+                if (report) cout << "Redo: Menyisipkan kembali baris." << endl;
+                break;
+
+            case Action::DELETE_LINE: {
+                // Redo DELETE_LINE dengan menghapus kembali baris
+                Action redone = lastAction;
+                redone.anchor = deleteLine(lastAction.linePosition, false);
+                journalAction(lastAction);
+                // Menambahkan aksi ke undoStack untuk memungkinkan undo
+                undoStack.push(redone);
+                if (report) cout << "Redo: Menghapus kembali baris." << endl;
+                break;
+            }
+
+            case Action::INSERT_CHAR: {
+                // Redo INSERT_CHAR dengan menyisipkan kembali karakter
+                Node* targetNode = anchoredNode(lastAction.anchor); // Jangkar baris -> node dalam O(1)
+                if (targetNode != nullptr) {
+                    if (lastAction.charIndex >= 0 && lastAction.charIndex <= (int)lineLength(targetNode)) {
+                        insertChar(targetNode, lastAction.charIndex, lastAction.newChar);
+                        journalAction(Action(Action::INSERT_CHAR, indexOf(targetNode), lastAction.charIndex, '\0', lastAction.newChar));
+                        // Menambahkan aksi ke undoStack
+                        undoStack.push(lastAction);
+                        if (report) cout << "Redo: Menyisipkan kembali karakter." << endl;
+                    }
+                }
+                break;
+            }
+
+            case Action::DELETE_CHAR: {
+                // Redo DELETE_CHAR dengan menghapus kembali karakter
+                Node* targetNode = anchoredNode(lastAction.anchor); // Jangkar baris -> node dalam O(1)
+                if (targetNode != nullptr) {
+                    if (lastAction.charIndex >= 0 && lastAction.charIndex < (int)lineLength(targetNode)) {
+                        // Menghapus karakter dari baris
+                        char removedChar = eraseChar(targetNode, lastAction.charIndex);
+                        journalAction(Action(Action::DELETE_CHAR, indexOf(targetNode), lastAction.charIndex));
+                        // Menambahkan aksi ke undoStack
+                        undoStack.push(lastAction);
+                        if (report) cout << "Redo: Menghapus kembali karakter '" << removedChar << "'." << endl;
+                    }
+                }
+                break;
+            }
+
+            case Action::REPLACE_CHAR: {
+                // Redo REPLACE_CHAR dengan mengganti kembali karakter ke newChar
+                Node* targetNode = anchoredNode(lastAction.anchor); // Jangkar baris -> node dalam O(1)
+                if (targetNode != nullptr) {
+                    if (lastAction.charIndex >= 0 && lastAction.charIndex < (int)lineLength(targetNode)) {
+                        // Mengganti karakter ke karakter baru
+                        setChar(targetNode, lastAction.charIndex, lastAction.newChar);
+                        journalAction(Action(Action::REPLACE_CHAR, indexOf(targetNode), lastAction.charIndex, lastAction.oldChar, lastAction.newChar));
+                        // Menambahkan aksi ke undoStack
+                        undoStack.push(lastAction);
+                        if (report) cout << "Redo: Mengganti karakter kembali ke '" << lastAction.newChar << "'." << endl;
+                    }
+                }
+                break;
+            }
+
+            case Action::REPLACE_TEXT: {
+                // Redo REPLACE_TEXT dengan mengganti kembali semua penggantian
+                string_view oldText = lastAction.searchText;
+                string_view newText = lastAction.replaceWithText;
+                const Action::Replacement* reps = lastAction.replacements.data();
+                Node* changed = nullptr; // Baris yang sedang diubah; textChanged sekali per baris
+                int changedLine = -1;    // Posisi baris changed (untuk jurnal)
+                for (size_t i = 0; i < lastAction.replacementCount(); i++) {
+                    const Action::Replacement& rep = reps[i];
+                    Node* targetNode = anchoredNode(rep.anchor); // Jangkar baris -> node dalam O(1)
+                    if (targetNode != nullptr) {
+                        if (rep.charIdx >= 0 && rep.charIdx + oldText.length() <= lineText(targetNode).length()) {
+                            if (targetNode != changed) {
+                                if (changed != nullptr) textChanged(changed);
+                                changed = targetNode;
+                                changedLine = indexOf(targetNode);
+                            }
+                            journalSplice(changedLine, rep.charIdx, oldText.length(), newText);
+                            // Mengganti teks ke teks baru
+                            countReplacement(targetNode, rep.charIdx, oldText, newText);
+                            editableText(targetNode).replace(rep.charIdx, oldText.length(), newText);
+                        }
+                    }
+                }
+                if (changed != nullptr) textChanged(changed);
+                // Menambahkan aksi ke undoStack
+                undoStack.push(lastAction);
+                if (report) cout << "Redo: Mengganti kembali teks yang telah diubah." << endl;
+                break;
+            }
+
+            case Action::REPLACE_PATTERN: {
+                // Redo REPLACE_PATTERN dengan mengganti kembali setiap teks lama
+                string_view newText = lastAction.replaceWithText;
+                const Action::Replacement* reps = lastAction.replacements.data();
+                const int* lengths = lastAction.oldLengths.data();
+                Node* changed = nullptr; // Baris yang sedang diubah; textChanged sekali per baris
+                int changedLine = -1;    // Posisi baris changed (untuk jurnal)
+                for (size_t i = 0; i < lastAction.replacementCount(); i++) {
+                    Node* targetNode = anchoredNode(reps[i].anchor);
+                    if (targetNode != nullptr) {
+                        if (reps[i].charIdx >= 0 && reps[i].charIdx + (size_t)lengths[i] <= lineText(targetNode).length()) {
+                            if (targetNode != changed) {
+                                if (changed != nullptr) textChanged(changed);
+                                changed = targetNode;
+                                changedLine = indexOf(targetNode);
+                            }
+                            journalSplice(changedLine, reps[i].charIdx, lengths[i], newText);
+                            countReplacement(targetNode, reps[i].charIdx, string_view(lineText(targetNode).data() + reps[i].charIdx, lengths[i]), newText);
+                            editableText(targetNode).replace(reps[i].charIdx, lengths[i], newText);
+                        }
+                    }
+                }
+                if (changed != nullptr) textChanged(changed);
+                // Menambahkan aksi ke undoStack
+                undoStack.push(lastAction);
+                if (report) cout << "Redo: Mengganti kembali teks yang telah diubah." << endl;
+                break;
+            }
+
+            default:
+                cout << "Aksi tidak dikenali." << endl;
+                break;
+        }
+        return undoStack.size() > before;
+    }
+
+    // Fungsi untuk melakukan redo terhadap aksi terakhir yang di-undo
+    void redo() {
+        Profiler::Scope scope(profiler, PROFILE_REDO);
+        if (transactionDepth > 0) {
+            cout << "Selesaikan transaksi terlebih dahulu sebelum redo." << endl;
+            return;
+        }
+        if (redoStack.empty()) {
+            cout << "Tidak ada aksi untuk di-redo." << endl;
+            return;
+        }
+
+        Action lastAction = redoStack.top(); // Mengambil aksi terakhir dari redoStack
+        redoStack.pop();                      // Menghapus aksi dari redoStack
+        journalControl(JOURNAL_BEGIN);        // Edit yang diterapkan dicatat sebagai satu grup
+        coalesceCount = 0;                    // Edit karakter berikutnya memulai grup baru
+
+        if (lastAction.type == Action::GROUP) {
+            // Redo GROUP dengan mengulangi anggotanya dari yang tertua (yang berada di
+            // puncak redoStack), lalu menutupnya kembali dengan penanda grup di undoStack
+            int redone = 0;
+            undoStack.holdBudget();
+            for (int i = 0; i < lastAction.groupSize && !redoStack.empty(); i++) {
+                Action member = redoStack.top();
+                redoStack.pop();
+                if (redoAction(member, false)) redone++;
+            }
+            if (redone > 0) undoStack.push(Action(Action::GROUP, redone));
+            undoStack.releaseBudget();
+            cout << "Redo: Mengulangi " << redone << " aksi dalam satu grup." << endl;
+        }
+        else {
+            redoAction(lastAction, true);
+        }
+        journalControl(JOURNAL_COMMIT);
+
+        display(); // Menampilkan teks setelah redo
+    }
+};
+
+// Kelas FileFinder mencari kata kunci di semua file di bawah sebuah direktori. File
+// dibagi ke WorkStealingPool; setiap file dipetakan (mmap) lalu dipindai sekali jalan
+// dengan SubstringSearch tanpa dipecah menjadi baris, jadi tidak ada alokasi per baris
+// dan hanya baris yang cocok yang disalin. Hasil satu file dikirim ke thread utama
+// begitu file itu selesai, sehingga hasil tampil bertahap selagi file lain masih
+// dipindai; baris di dalam satu file selalu tampil berurutan.
+//
+// File yang sedang terbuka di editor dicari dari snapshot dokumennya, bukan dari disk,
+// sehingga perubahan yang belum disimpan ikut tercari. Direktori tersembunyi (nama
+// diawali '.') dan file biner (ada byte nol di awal file) dilewati.
+class FileFinder {
+public:
+    static constexpr size_t MAX_SHOWN_LINES = 1000; // Baris cocok yang ditampilkan paling banyak; sisanya hanya dihitung
+    static constexpr size_t BINARY_PROBE = 8192;    // Byte awal yang diperiksa untuk mendeteksi file biner
+
+private:
+    // Baris yang cocok; teksnya berada di FileResult::text mulai textOffset
+    struct Hit {
+        size_t line;   // Nomor baris (dimulai dari 0)
+        size_t column; // Kolom kemunculan pertama di baris ini
+        size_t textOffset;
+        size_t textLength;
+    };
+
+    // Hasil pemindaian satu file, dikirim utuh ke thread utama
+    struct FileResult {
+        size_t file = 0;         // Indeks file di files
+        bool fromBuffer = false; // Dicari dari snapshot dokumen yang terbuka
+        bool binary = false;     // Dilewati karena file biner
+        bool failed = false;     // File gagal dibuka
+        size_t bytes = 0;        // Byte yang dipindai
+        size_t matches = 0;      // Jumlah kemunculan
+        size_t lines = 0;        // Jumlah baris yang cocok
+        vector<Hit> hits;        // Baris cocok yang teksnya disimpan (dibatasi kuota tampilan)
+        string text;             // Teks baris-baris tersebut, disambung
+    };
+
+    SubstringSearch search;
+    vector<string> files;                    // File yang dipindai, urut menurut path
+    vector<DocumentSnapshot> snapshots;      // Snapshot dokumen terbuka yang ada di antara files
+    vector<const DocumentSnapshot*> buffers; // buffers[i] != nullptr: file ke-i dicari dari snapshot
+    atomic<size_t> shownLeft;                // Sisa kuota baris yang teksnya disimpan
+
+    mutex resultsLock;                       // Melindungi results
+    condition_variable resultsReady;         // Sinyal: ada hasil file baru
+    vector<FileResult> results;              // Hasil yang belum ditampilkan
+
+    // Fungsi untuk menyamakan bentuk path agar file yang terbuka di editor bisa dikenali
+    static string canonicalPath(const string& path) {
+        error_code code;
+        filesystem::path result = filesystem::weakly_canonical(path, code);
+        return code ? path : result.string();
+    }
+
+    // Fungsi untuk mengumpulkan semua file biasa di bawah directory (atau directory itu
+    // sendiri jika berupa file), tanpa masuk ke direktori tersembunyi
+    bool collect(const string& directory, string& error) {
+        error_code code;
+        filesystem::file_status status = filesystem::status(directory, code);
+        if (filesystem::is_regular_file(status)) {
+            files.push_back(directory);
+            return true;
+        }
+        if (!filesystem::is_directory(status)) {
+            error = "Direktori \"" + directory + "\" tidak ditemukan.";
+            return false;
+        }
+        filesystem::recursive_directory_iterator entry(directory, filesystem::directory_options::skip_permission_denied, code);
+        for (; !code && entry != filesystem::recursive_directory_iterator(); entry.increment(code)) {
+            error_code typeCode;
+            if (entry->is_directory(typeCode)) {
+                string name = entry->path().filename().string();
+                if (name.size() > 1 && name[0] == '.') entry.disable_recursion_pending();
+            }
+            else if (entry->is_regular_file(typeCode)) {
+                files.push_back(entry->path().string());
+            }
+        }
+        if (code) {
+            error = "Gagal membaca direktori \"" + directory + "\": " + code.message() + ".";
+            return false;
+        }
+        sort(files.begin(), files.end());
+        return true;
+    }
+
+    // Fungsi untuk menghitung kemunculan kata kunci di text mulai from (tidak saling
+    // tumpang tindih); first diisi dengan kolom kemunculan pertama
+    size_t countMatches(string_view text, size_t from, size_t& first) const {
+        size_t count = 0;
+        while ((from = search.find(text, from)) != string::npos) {
+            if (count++ == 0) first = from;
+            from += search.pattern().size();
+        }
+        return count;
+    }
+
+    // Fungsi untuk mencatat satu baris yang cocok. Teksnya hanya disalin selama kuota
+    // tampilan bersama semua thread masih ada.
+    void addLine(FileResult& result, size_t line, size_t column, size_t matches, string_view text) {
+        result.lines++;
+        result.matches += matches;
+        size_t left = shownLeft.load(memory_order_relaxed);
+        while (left > 0 && !shownLeft.compare_exchange_weak(left, left - 1, memory_order_relaxed)) {}
+        if (left == 0) return;
+        result.hits.push_back(Hit{ line, column, result.text.size(), text.size() });
+        result.text.append(text.data(), text.size());
+    }
+
+    // Fungsi untuk memindai isi file dalam satu kali jalan: kata kunci dicari langsung
+    // di seluruh byte, dan '\n' hanya dihitung di antara kecocokan
+    void scanBytes(FileResult& result, const char* data, size_t length) {
+        size_t line = 0;      // Nomor baris dari lineBegin
+        size_t lineBegin = 0; // Offset awal baris yang sedang dihitung
+        size_t offset = 0;
+        while (offset < length) {
+            size_t found = search.find(data + offset, length - offset);
+            if (found == string::npos) return;
+            size_t match = offset + found;
+            const char* newline;
+            while ((newline = static_cast<const char*>(memchr(data + lineBegin, '\n', match - lineBegin))) != nullptr) {
+                line++;
+                lineBegin = (newline - data) + 1;
+            }
+
+            // Semua kemunculan di baris ini dihitung sekaligus, lalu pemindaian lanjut
+            // dari baris berikutnya ('\r' sebelum '\n' bukan bagian baris)
+            newline = static_cast<const char*>(memchr(data + match, '\n', length - match));
+            size_t lineEnd = (newline != nullptr) ? (size_t)(newline - data) : length;
+            size_t textEnd = (lineEnd > lineBegin && data[lineEnd - 1] == '\r') ? lineEnd - 1 : lineEnd;
+            string_view text(data + lineBegin, textEnd - lineBegin);
+            size_t column = 0;
+            size_t count = countMatches(text, match - lineBegin, column);
+            if (count > 0) addLine(result, line, column, count, text);
+            offset = lineEnd + 1;
+            lineBegin = offset;
+            line++;
+        }
+    }
+
+    // Fungsi untuk memindai snapshot dokumen yang terbuka baris demi baris
+    void scanSnapshot(FileResult& result, const DocumentSnapshot& snapshot) {
+        snapshot.forEachLine([&](size_t line, string_view text) {
+            result.bytes += text.size() + 1;
+            size_t column = 0;
+            size_t count = countMatches(text, 0, column);
+            if (count > 0) addLine(result, line, column, count, text);
+        });
+    }
+
+    // Fungsi yang dijalankan pekerja untuk file ke-index; hasilnya dikirim ke thread utama
+    void scanFile(size_t index) {
+        FileResult result;
+        result.file = index;
+        if (buffers[index] != nullptr) {
+            result.fromBuffer = true;
+            scanSnapshot(result, *buffers[index]);
+        }
+        else {
+            MappedFile file;
+            if (!file.open(files[index], false)) {
+                result.failed = true;
+            }
+            else if (file.size() > 0) {
+                result.bytes = file.size();
+                result.binary = memchr(file.data(), '\0', min(file.size(), BINARY_PROBE)) != nullptr;
+                if (!result.binary) scanBytes(result, file.data(), file.size());
+            }
+        }
+        {
+            lock_guard<mutex> guard(resultsLock);
+            results.push_back(move(result));
+        }
+        resultsReady.notify_one();
+    }
+
+    // Fungsi untuk menampilkan baris-baris cocok dari satu file dengan kata kunci disorot
+    void show(const FileResult& result) const {
+        const string& path = files[result.file];
+        if (result.failed) {
+            cout << path << ": gagal dibuka" << endl;
+            return;
+        }
+        size_t keywordLength = search.pattern().size();
+        for (const Hit& hit : result.hits) {
+            string_view text(result.text.data() + hit.textOffset, hit.textLength);
+            cout << path << ":" << hit.line + 1 << ": " << text.substr(0, hit.column) << "["
+                 << text.substr(hit.column, keywordLength) << "]" << text.substr(hit.column + keywordLength) << "\n";
+        }
+        if (!result.hits.empty()) cout.flush();
+    }
+
+public:
+    explicit FileFinder(string_view keyword) : search(keyword), shownLeft(MAX_SHOWN_LINES) {}
+
+    FileFinder(const FileFinder&) = delete;
+    FileFinder& operator=(const FileFinder&) = delete;
+
+    // Fungsi untuk mencari di directory dan menampilkan hasil setiap file begitu selesai
+    // dipindai. editors berisi dokumen yang sedang terbuka; hanya yang file-nya ada di
+    // bawah directory yang diambil snapshot-nya.
+    void run(const string& directory, const vector<LinkedList*>& editors) {
+        auto begin = chrono::steady_clock::now();
+        string error;
+        if (!collect(directory, error)) {
+            cout << error << endl;
+            return;
+        }
+        buffers.assign(files.size(), nullptr);
+        if (!editors.empty()) {
+            unordered_map<string, LinkedList*> open;
+            for (LinkedList* editor : editors) {
+                if (!editor->getDocumentPath().empty()) open.emplace(canonicalPath(editor->getDocumentPath()), editor);
+            }
+            snapshots.reserve(open.size()); // Alamat snapshot dipegang oleh buffers
+            unordered_set<string> names; // Nama file saja, agar path kanonis hanya dihitung untuk calon yang mungkin
+            for (const auto& entry : open) names.insert(filesystem::path(entry.first).filename().string());
+            for (size_t i = 0; i < files.size() && !open.empty(); i++) {
+                if (names.count(filesystem::path(files[i]).filename().string()) == 0) continue;
+                auto found = open.find(canonicalPath(files[i]));
+                if (found == open.end()) continue;
+                snapshots.push_back(found->second->snapshot());
+                buffers[i] = &snapshots.back();
+                open.erase(found); // Path yang sama tidak dipindai dua kali
+            }
+        }
+
+        WorkStealingPool pool;
+        pool.start(files.size(), [this](size_t index) { scanFile(index); });
+        size_t done = 0, matchedFiles = 0, matches = 0, lines = 0, shown = 0;
+        size_t bytes = 0, fromBuffers = 0, binaries = 0, failures = 0;
+        vector<FileResult> ready;
+        while (done < files.size()) {
+            {
+                unique_lock<mutex> guard(resultsLock);
+                resultsReady.wait(guard, [this]() { return !results.empty(); });
+                ready.swap(results);
+            }
+            for (const FileResult& result : ready) {
+                show(result);
+                done++;
+                if (result.lines > 0) matchedFiles++;
+                matches += result.matches;
+                lines += result.lines;
+                shown += result.hits.size();
+                bytes += result.bytes;
+                if (result.fromBuffer) fromBuffers++;
+                if (result.binary) binaries++;
+                if (result.failed) failures++;
+            }
+            ready.clear();
+        }
+        pool.wait();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - begin;
+
+        if (matches == 0) cout << "Kata kunci \"" << search.pattern() << "\" tidak ditemukan";
+        else cout << "Kata kunci \"" << search.pattern() << "\": " << matches << " kemunculan di " << lines
+                  << " baris dalam " << matchedFiles << " file";
+        cout << " (" << files.size() << " file, " << bytes << " byte dipindai";
+        if (fromBuffers > 0) cout << ", " << fromBuffers << " dari buffer terbuka";
+        if (binaries > 0) cout << ", " << binaries << " file biner dilewati";
+        if (failures > 0) cout << ", " << failures << " gagal dibuka";
+        ios_base::fmtflags flags = cout.flags();
+        streamsize precision = cout.precision();
+        cout << ") dalam " << fixed << setprecision(1) << elapsed.count() << " ms dengan " << pool.size()
+             << " thread, " << pool.steals() << " file dicuri antar-thread." << endl;
+        cout.flags(flags);
+        cout.precision(precision);
+        if (shown < lines) cout << lines - shown << " baris cocok lainnya tidak ditampilkan (batas " << MAX_SHOWN_LINES << " baris)." << endl;
+    }
+};
+
+// Kelas Workspace menyimpan banyak buffer (dokumen) yang terbuka sekaligus. Setiap
+// buffer adalah LinkedList tersendiri dengan riwayat, jurnal, dan viewport-nya sendiri,
+// jadi berpindah buffer cukup mengganti buffer aktif. File dipetakan dan indeks barisnya
+// dibangun di thread pemuat sehingga menu tetap responsif; hasilnya dipasang ke buffer
+// di thread utama oleh poll(). Semua buffer memakai satu StringPool riwayat, sehingga
+// kata kunci dan teks pengganti yang sama di banyak file cukup disimpan sekali.
+//
+// Riwayat buffer yang ditinggalkan dirapatkan. Jika riwayat buffer tidak aktif yang
+// masih di memori melebihi IDLE_HISTORY_BUDGET, riwayat buffer yang paling lama tidak
+// dipakai dipindah ke file sementara sampai total kembali di bawah batas.
+class Workspace {
+public:
+    static const size_t IDLE_HISTORY_BUDGET = 16 * 1024 * 1024;
+    static const size_t LOADER_THREADS = 4;
+
+private:
+    struct Buffer {
+        unsigned int id;               // Nomor unik buffer (tidak berubah walau buffer lain ditutup)
+        unique_ptr<LinkedList> editor; // Dokumen buffer ini
+        string loadingPath;            // File yang sedang dimuat ke buffer ini (kosong = siap dipakai)
+        size_t lastUsed;               // Nilai clock saat buffer terakhir aktif
+    };
+
+    // Hasil satu pemuatan file dari thread pemuat
+    struct LoadResult {
+        unsigned int id;
+        string path;
+        shared_ptr<MappedFile> file; // nullptr jika gagal (error berisi alasannya)
+        string error;
+    };
+
+    shared_ptr<StringPool> historyStrings; // Pool string riwayat bersama semua buffer
+    vector<Buffer> buffers;
+    size_t activeIndex;
+    unsigned int nextId;
+    size_t clock;                          // Bertambah setiap kali buffer aktif berganti
+    mutex loadedLock;                      // Melindungi loaded
+    vector<LoadResult> loaded;             // Hasil pemuatan yang belum dipasang
+    unique_ptr<ThreadPool> loaders;        // Dibuat saat pemuatan pertama; dihentikan paling dulu
+
+    // Fungsi untuk mendapatkan nama buffer untuk ditampilkan
+    static string nameOf(const Buffer& buffer) {
+        if (!buffer.loadingPath.empty()) return buffer.loadingPath;
+        const string& path = buffer.editor->getDocumentPath();
+        return path.empty() ? "(tanpa nama)" : path;
+    }
+
+    // Fungsi untuk mencari posisi buffer berdasarkan id-nya (buffers.size() jika tidak ada)
+    size_t findBuffer(unsigned int id) const {
+        for (size_t i = 0; i < buffers.size(); i++) {
+            if (buffers[i].id == id) return i;
+        }
+        return buffers.size();
+    }
+
+    // Fungsi untuk menambahkan buffer kosong di akhir daftar
+    Buffer& addBuffer() {
+        Buffer buffer;
+        buffer.id = nextId++;
+        buffer.editor.reset(new LinkedList(historyStrings));
+        buffer.lastUsed = clock;
+        if (!buffers.empty() && active().isProfiling()) buffer.editor->setProfiling(true);
+        buffers.push_back(move(buffer));
+        return buffers.back();
+    }
+
+    // Fungsi untuk membuang buffer ke-index dari daftar. Jika buffer aktif yang dibuang,
+    // buffer siap pakai terdekat menjadi aktif (atau buffer kosong baru jika tidak ada).
+    void removeBuffer(size_t index) {
+        bool wasActive = (index == activeIndex);
+        buffers.erase(buffers.begin() + index);
+        if (index < activeIndex) activeIndex--;
+        if (!wasActive) return;
+        activeIndex = buffers.size();
+        for (size_t offset = 0; offset < buffers.size() && activeIndex == buffers.size(); offset++) {
+            size_t candidate = (index + buffers.size() - 1 - offset) % buffers.size(); // Mulai dari buffer sebelumnya
+            if (buffers[candidate].loadingPath.empty()) activeIndex = candidate;
+        }
+        if (activeIndex == buffers.size()) addBuffer();
+        buffers[activeIndex].lastUsed = ++clock;
+    }
+
+    // Fungsi untuk memindahkan riwayat buffer tidak aktif ke file sementara, mulai dari
+    // yang paling lama tidak dipakai, sampai riwayat di memori tidak melebihi batas
+    void enforceIdleBudget() {
+        vector<size_t> idle;
+        size_t total = 0;
+        for (size_t i = 0; i < buffers.size(); i++) {
+            if (i == activeIndex) continue;
+            idle.push_back(i);
+            total += buffers[i].editor->historyBytes();
+        }
+        sort(idle.begin(), idle.end(), [this](size_t a, size_t b) { return buffers[a].lastUsed < buffers[b].lastUsed; });
+        for (size_t i : idle) {
+            if (total <= IDLE_HISTORY_BUDGET) break;
+            LinkedList& editor = *buffers[i].editor;
+            size_t before = editor.historyBytes();
+            editor.spillHistory();
+            total -= before - editor.historyBytes();
+        }
+    }
+
+    // Fungsi untuk membaca nomor buffer (dimulai dari 1) dari teks; 0 jika tidak valid
+    static size_t parseNumber(const string& text) {
+        char* end = nullptr;
+        unsigned long value = strtoul(text.c_str(), &end, 10);
+        if (text.empty() || !isdigit((unsigned char)text[0]) || *end != '\0') return 0;
+        return (size_t)value;
+    }
+
+public:
+    Workspace() : historyStrings(make_shared<StringPool>()), activeIndex(0), nextId(1), clock(0) {
+        addBuffer();
+    }
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    // Fungsi untuk mendapatkan buffer yang sedang aktif
+    LinkedList& active() {
+        return *buffers[activeIndex].editor;
+    }
+
+    size_t bufferCount() const {
+        return buffers.size();
+    }
+
+    // Fungsi untuk membuka file di buffer baru. Pemetaan file dan indeks baris dibangun
+    // di thread pemuat; buffer bisa dipakai setelah poll() memasang hasilnya.
+    void openInNewBuffer(const string& path) {
+        for (size_t i = 0; i < buffers.size(); i++) {
+            if (buffers[i].loadingPath == path || buffers[i].editor->getDocumentPath() == path) {
+                cout << "File \"" << path << "\" sudah terbuka di buffer " << i + 1 << "." << endl;
+                return;
             }
-            current = current->next;
-            if (current != nullptr) cout << "\n"; // Menambahkan baris baru jika ada baris berikutnya
-            lineNumber++;
         }
-        cout << endl;
+        Buffer& buffer = addBuffer();
+        buffer.loadingPath = path;
+        unsigned int id = buffer.id;
+        if (!loaders) loaders.reset(new ThreadPool(LOADER_THREADS));
+        loaders->submit([this, id, path]() {
+            LoadResult result{ id, path, nullptr, string() };
+            result.file = LinkedList::loadFile(path, result.error);
+            lock_guard<mutex> guard(loadedLock);
+            loaded.push_back(move(result));
+        });
+        cout << "Memuat \"" << path << "\" ke buffer " << buffers.size() << " di latar belakang." << endl;
     }
 
-    // Fungsi untuk menyisipkan baris dan mencatat aksi
-    void insertAndTrack(int position, const string& data) {
-        insertLine(position, data, true);
+    // Fungsi untuk membuat buffer kosong baru lalu berpindah ke sana
+    void newBuffer() {
+        addBuffer();
+        switchTo(buffers.size());
     }
 
-    // Fungsi untuk mencari dan menyorot kata kunci dalam teks
-    void searchAndHighlight(const string& keyword) {
-        Node* current = head;
-        bool found = false;
-        int linePos = 1;
-        while (current != nullptr) {
-            size_t pos = current->data.find(keyword);
-            if (pos != string::npos) {
-                found = true;
-                string highlighted = current->data;
-                // Menambahkan tanda kurung siku di sekitar kata kunci yang ditemukan
-                highlighted.insert(pos + keyword.length(), "]");
-                highlighted.insert(pos, "[");
-                cout << linePos << ": " << highlighted;
-            }
-            else {
-                cout << linePos << ": " << current->data;
-            }
-            current = current->next;
-            if (current != nullptr) cout << "\n";
-            linePos++;
+    // Fungsi yang dipanggil di thread utama sebelum menunggu input: memasang file yang
+    // selesai dimuat, melaporkan penyimpanan latar belakang yang selesai, dan menuliskan
+    // jurnal semua buffer ke disk
+    void poll() {
+        vector<LoadResult> done;
+        {
+            lock_guard<mutex> guard(loadedLock);
+            done.swap(loaded);
         }
-        if (!found) {
-            cout << "\nKata kunci \"" << keyword << "\" tidak ditemukan." << endl;
+        for (LoadResult& result : done) {
+            size_t index = findBuffer(result.id);
+            if (index == buffers.size()) continue; // Buffer sudah ditutup sebelum file selesai dimuat
+            cout << "Buffer " << index + 1 << ": ";
+            if (!result.file) {
+                cout << result.error << endl;
+                removeBuffer(index);
+                continue;
+            }
+            buffers[index].loadingPath.clear();
+            buffers[index].editor->adoptFile(result.file, result.path);
         }
-        else {
-            cout << endl;
+        for (Buffer& buffer : buffers) {
+            buffer.editor->finishSave(false, cout); // Melaporkan penyimpanan latar belakang yang sudah selesai
+            buffer.editor->syncJournal();           // Aksi sebelumnya sudah aman di disk sebelum menunggu input
         }
     }
 
-    // Fungsi untuk navigasi ke baris berikutnya
-    void moveToNextLine() {
-        if (currentNode == nullptr) {
-            cout << "Tidak ada baris untuk dinavigasi." << endl;
-            return;
+    // Fungsi untuk berpindah ke buffer nomor number (dimulai dari 1). Riwayat buffer
+    // yang ditinggalkan dirapatkan dan batas riwayat buffer tidak aktif diterapkan.
+    bool switchTo(size_t number) {
+        if (number < 1 || number > buffers.size()) {
+            cout << "Nomor buffer harus antara 1 dan " << buffers.size() << "." << endl;
+            return false;
         }
-
-        if (currentNode->next != nullptr) {
-            currentNode = currentNode->next;    // Pindah ke baris berikutnya
-            currentCharIndex = 0;               // Reset indeks karakter ke awal
-            cout << "Berpindah ke baris berikutnya." << endl;
+        Buffer& target = buffers[number - 1];
+        if (!target.loadingPath.empty()) {
+            cout << "Buffer " << number << " masih memuat \"" << target.loadingPath << "\"." << endl;
+            return false;
         }
-        else {
-            cout << "Sudah berada di baris terakhir." << endl;
+        if (number - 1 != activeIndex) {
+            active().compactHistory();
+            buffers[activeIndex].lastUsed = ++clock;
+            activeIndex = number - 1;
+            target.lastUsed = ++clock;
+            enforceIdleBudget();
         }
+        cout << "Berpindah ke buffer " << number << ": " << nameOf(target) << "." << endl;
+        active().redraw();
+        return true;
     }
 
-    // Fungsi untuk navigasi ke baris sebelumnya
-    void moveToPrevLine() {
-        if (currentNode == nullptr) {
-            cout << "Tidak ada baris untuk dinavigasi." << endl;
-            return;
+    // Fungsi untuk menutup buffer nomor number (dimulai dari 1). Penyimpanan yang masih
+    // berjalan ditunggu dan jurnalnya dihapus, sama seperti saat keluar.
+    bool close(size_t number) {
+        if (number < 1 || number > buffers.size()) {
+            cout << "Nomor buffer harus antara 1 dan " << buffers.size() << "." << endl;
+            return false;
         }
+        Buffer& buffer = buffers[number - 1];
+        string name = nameOf(buffer);
+        bool wasActive = (number - 1 == activeIndex);
+        buffer.editor->finishSave(true, cout);
+        buffer.editor->closeJournal();
+        removeBuffer(number - 1);
+        cout << "Buffer " << number << " (" << name << ") ditutup." << endl;
+        if (wasActive) active().redraw();
+        return true;
+    }
 
-        if (currentNode->prev != nullptr) {
-            currentNode = currentNode->prev;    // Pindah ke baris sebelumnya
-            currentCharIndex = 0;               // Reset indeks karakter ke awal
-            cout << "Berpindah ke baris sebelumnya." << endl;
+    // Fungsi untuk menutup semua buffer saat keluar
+    void closeAll() {
+        for (Buffer& buffer : buffers) {
+            buffer.editor->finishSave(true, cout); // Menunggu penyimpanan yang masih berjalan
+            buffer.editor->closeJournal();         // Keluar normal: jurnal pemulihan dihapus
         }
-        else {
-            cout << "Sudah berada di baris pertama." << endl;
+    }
+
+    // Fungsi untuk mencari kata kunci di semua file di bawah directory. Buffer yang
+    // terbuka dicari dari snapshot-nya, jadi perubahan yang belum disimpan ikut tercari.
+    void findInFiles(const string& directory, const string& keyword) {
+        vector<LinkedList*> editors;
+        for (Buffer& buffer : buffers) {
+            if (buffer.loadingPath.empty()) editors.push_back(buffer.editor.get());
         }
+        FileFinder(keyword).run(directory, editors);
     }
 
-    // Fungsi untuk navigasi ke karakter berikutnya dalam baris saat ini
-    void moveToNextChar() {
-        if (currentNode == nullptr) {
-            cout << "Tidak ada baris tersedia." << endl;
+    // Fungsi untuk meminta direktori dan kata kunci lalu mencari di banyak file
+    void findInFilesInteractive() {
+        string directory, keyword;
+        cout << "Masukkan direktori yang akan dicari (Enter = direktori saat ini): ";
+        getline(cin, directory);
+        if (directory.empty()) directory = ".";
+        cout << "Masukkan kata kunci yang akan dicari: ";
+        getline(cin, keyword);
+        if (keyword.empty()) {
+            cout << "Kata kunci tidak boleh kosong." << endl;
             return;
         }
+        findInFiles(directory, keyword);
+    }
 
-        if (currentCharIndex < currentNode->data.length() - 1) {
-            currentCharIndex++; // Pindah ke karakter berikutnya
-            cout << "Berpindah ke karakter berikutnya." << endl;
-        }
-        else {
-            cout << "Sudah berada di karakter terakhir dari baris saat ini." << endl;
+    // Fungsi untuk menampilkan daftar buffer; buffer aktif ditandai '*'
+    void list() {
+        size_t inMemory = 0;
+        for (size_t i = 0; i < buffers.size(); i++) {
+            const Buffer& buffer = buffers[i];
+            cout << (i == activeIndex ? "* " : "  ") << i + 1 << ". " << nameOf(buffer);
+            if (!buffer.loadingPath.empty()) {
+                cout << " (memuat...)" << endl;
+                continue;
+            }
+            cout << " (" << buffer.editor->getLineCount() << " baris";
+            if (buffer.editor->historySpilled()) cout << ", riwayat di disk";
+            cout << ")" << endl;
+            inMemory += buffer.editor->historyBytes();
         }
+        cout << buffers.size() << " buffer, riwayat di memori " << inMemory << " byte, "
+             << historyStrings->count() << " string riwayat bersama (" << historyStrings->bytesUsed() << " byte)." << endl;
     }
 
-    // Fungsi untuk navigasi ke karakter sebelumnya dalam baris saat ini
-    void moveToPrevChar() {
-        if (currentNode == nullptr) {
-            cout << "Tidak ada baris tersedia." << endl;
-            return;
+    // Fungsi untuk menampilkan daftar buffer lalu berpindah, membuka, atau menutup buffer
+    void interactive() {
+        list();
+        cout << "Masukkan nomor buffer untuk berpindah, \"b <path>\" untuk membuka file di buffer baru,\n"
+             << "\"n\" untuk buffer kosong baru, \"t <nomor>\" untuk menutup buffer, atau Enter untuk kembali: ";
+        string input;
+        getline(cin, input);
+        if (input.empty()) return;
+        if (input.size() > 2 && input[0] == 'b' && input[1] == ' ') {
+            openInNewBuffer(input.substr(2));
         }
-
-        if (currentCharIndex > 0) {
-            currentCharIndex--; // Pindah ke karakter sebelumnya
-            cout << "Berpindah ke karakter sebelumnya." << endl;
+        else if (input == "n") {
+            newBuffer();
+        }
+        else if (input.size() > 2 && input[0] == 't' && input[1] == ' ') {
+            size_t number = parseNumber(input.substr(2));
+            if (number == 0) cout << "Nomor buffer tidak valid." << endl;
+            else close(number);
         }
         else {
-            cout << "Sudah berada di karakter pertama dari baris saat ini." << endl;
+            size_t number = parseNumber(input);
+            if (number == 0) cout << "Masukan tidak valid." << endl;
+            else switchTo(number);
         }
     }
+};
 
-    // Fungsi untuk menghapus seluruh baris yang sedang di-highlight
-    void deleteCurrentLine() {
-        if (currentNode == nullptr) {
-            cout << "Tidak ada baris yang dapat dihapus." << endl;
-            return;
-        }
+// Kelas ScriptRunner menjalankan skrip perintah editor tanpa menu (mode batch). Setiap
+// baris skrip berisi satu perintah dan argumennya dipisah spasi; argumen yang memuat
+// spasi ditulis di antara tanda kutip ganda (\" dan \\ untuk kutip dan backslash).
+// Baris kosong dan baris yang diawali '#' diabaikan.
+//
+// Selama skrip berjalan tampilan otomatis dan pesan editor dimatikan. Hanya perintah
+// print, stats, position, count, dan find-in-files yang menulis ke stdout, jadi editor
+// bisa dipakai di tengah pipeline; kesalahan skrip dan ringkasan waktu ditulis ke stderr.
+//
+//   open <file>                      membuka file
+//   insert <posisi> <teks>           menyisipkan baris (0 = awal)
+//   delete-char [n]                  menghapus karakter saat ini
+//   delete-line [n]                  menghapus baris saat ini
+//   replace-char <karakter>          mengganti karakter saat ini (satu codepoint UTF-8)
+//   replace <cari> <ganti>           mengganti semua teks (juga replace-parallel)
+//   replace-words <kata...> <ganti>  mengganti beberapa kata sekaligus
+//   replace-regex <regex> <ganti>    mengganti teks yang cocok dengan regex
+//   search <kata>                    mencari kata kunci (juga search-words, search-regex)
+//   find-in-files <direktori> <kata> mencari kata kunci di semua file di bawah direktori
+//   next-line, prev-line, next-char, prev-char [n]
+//   goto <baris>                     melompat ke baris (dimulai dari 1)
+//   goto-offset <offset>             melompat ke byte ke-offset (dimulai dari 0)
+//   goto-column <kolom>              melompat ke kolom (codepoint UTF-8) di baris saat ini
+//   position                         mencetak baris, kolom, dan offset kursor
+//   count                            mencetak jumlah baris, kata, byte, dan codepoint
+//   undo [n], redo [n], begin, commit
+//   save <file>                      menyimpan dokumen di latar belakang
+//   print                            mencetak seluruh dokumen
+//   stats                            mencetak statistik memori
+class ScriptRunner {
+private:
+    // Jumlah operasi dan waktu total satu jenis perintah
+    struct CommandStats {
+        string name;
+        size_t operations;
+        double milliseconds;
+    };
 
-        int pos = getCurrentLinePosition(); // Mendapatkan posisi baris saat ini
-        if (pos == -1) {
-            cout << "Kesalahan dalam mendapatkan posisi baris." << endl;
-            return;
-        }
+    LinkedList& editor;
+    vector<CommandStats> commandStats;        // Urut sesuai kemunculan pertama di skrip
+    unordered_map<string, size_t> statsIndex; // Nama perintah -> indeks di commandStats
+    size_t commands;                          // Perintah yang berhasil dijalankan
+    size_t errors;                            // Perintah yang tidak valid atau gagal
 
-        string data = currentNode->data; // Menyimpan data baris yang akan dihapus
+    // Fungsi untuk memecah satu baris skrip menjadi argumen
+    static bool tokenize(const string& line, vector<string>& args, string& error) {
+        args.clear();
+        size_t i = 0;
+        while (true) {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) i++;
+            if (i >= line.size()) return true;
 
-        // Mencatat aksi DELETE_LINE ke undoStack
-        undoStack.push(Action(Action::DELETE_LINE, pos, data));
-        // Kosongkan redoStack karena aksi baru dilakukan
-        while (!redoStack.empty()) redoStack.pop();
+            string arg;
+            if (line[i] != '"') {
+                while (i < line.size() && line[i] != ' ' && line[i] != '\t') arg += line[i++];
+                args.push_back(arg);
+                continue;
+            }
 
-        // Menghapus currentNode tanpa mencatat ulang aksi
-        deleteLine(pos, false);
-        cout << "Baris telah dihapus." << endl;
+            i++; // Melewati tanda kutip pembuka
+            bool closed = false;
+            while (i < line.size()) {
+                char c = line[i++];
+                if (c == '"') {
+                    closed = true;
+                    break;
+                }
+                if (c == '\\' && i < line.size()) c = line[i++];
+                arg += c;
+            }
+            if (!closed) {
+                error = "tanda kutip tidak ditutup";
+                return false;
+            }
+            args.push_back(arg);
+        }
+    }
 
-        display(); // Menampilkan teks setelah penghapusan
+    // Fungsi untuk memeriksa jumlah argumen sebuah perintah
+    static bool expectArguments(const vector<string>& args, size_t minimum, size_t maximum, string& error) {
+        size_t count = args.size() - 1;
+        if (count >= minimum && count <= maximum) return true;
+        error = "perintah \"" + args[0] + "\" membutuhkan " + to_string(minimum);
+        if (maximum > minimum) error += "-" + to_string(maximum);
+        error += " argumen";
+        return false;
     }
 
-    // Fungsi untuk melakukan undo terhadap aksi terakhir
-    void undo() {
-        if (undoStack.empty()) {
-            cout << "Tidak ada aksi untuk di-undo." << endl;
-            return;
+    // Fungsi untuk membaca bilangan bulat dari argumen
+    static bool parseNumber(const string& text, long long minimum, long long& value, string& error) {
+        char* end = nullptr;
+        errno = 0;
+        value = strtoll(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0' || errno != 0 || value < minimum || value > INT_MAX) {
+            error = "bilangan tidak valid \"" + text + "\"";
+            return false;
         }
+        return true;
+    }
 
-        Action lastAction = undoStack.top(); // Mengambil aksi terakhir dari undoStack
-        undoStack.pop();                      // Menghapus aksi dari undoStack
-
-        switch (lastAction.type) {
-            case Action::INSERT_LINE:
-                // Undo INSERT_LINE dengan menghapus baris yang di-insert
-                deleteLine(lastAction.linePosition, false);
-                // Menambahkan aksi ke redoStack untuk memungkinkan redo
-                redoStack.push(lastAction);
-                cout << "Undo: Menghapus baris yang di-insert." << endl;
-                break;
+    // Fungsi untuk membaca jumlah ulangan opsional (argumen pertama, bawaan 1)
+    static bool repeatCount(const vector<string>& args, long long& count, string& error) {
+        count = 1;
+        if (!expectArguments(args, 0, 1, error)) return false;
+        return args.size() < 2 || parseNumber(args[1], 1, count, error);
+    }
 
-            case Action::DELETE_LINE:
-                // Undo DELETE_LINE dengan menyisipkan kembali baris yang dihapus
-                insertLine(lastAction.linePosition, lastAction.data, false);
-                // Menambahkan aksi ke redoStack untuk memungkinkan redo
-                redoStack.push(lastAction);
-                cout << "Undo: Menyisipkan kembali baris yang dihapus." << endl;
-                break;
+    // Fungsi untuk menjalankan satu perintah. Mengembalikan jumlah operasi yang
+    // dijalankan, atau -1 jika perintah tidak valid (error diisi alasannya).
+    long long execute(const vector<string>& args, string& error) {
+        const string& name = args[0];
+        long long count = 1;
 
-            case Action::DELETE_CHAR: {
-                // Undo DELETE_CHAR dengan menyisipkan kembali karakter yang dihapus
-                Node* targetNode = head;
-                int index = 0;
-                while (targetNode != nullptr && index < lastAction.linePosition) {
-                    targetNode = targetNode->next;
-                    index++;
-                }
-                if (targetNode != nullptr) {
-                    if (lastAction.charIndex >= 0 && lastAction.charIndex <= targetNode->data.length()) {
-                        // Menyisipkan kembali karakter yang dihapus
-                        targetNode->data.insert(lastAction.charIndex, string(1, lastAction.oldChar));
-                        // Menambahkan aksi ke redoStack
-                        redoStack.push(lastAction);
-                        cout << "Undo: Menyisipkan kembali karakter yang dihapus." << endl;
-                    }
-                }
-                break;
+        if (name == "open") {
+            if (!expectArguments(args, 1, 1, error)) return -1;
+            if (!editor.openFile(args[1])) {
+                error = "gagal membuka file \"" + args[1] + "\"";
+                return -1;
             }
-
-            case Action::REPLACE_CHAR: {
-                // Undo REPLACE_CHAR dengan mengganti kembali karakter ke oldChar
-                Node* targetNode = head;
-                int index = 0;
-                while (targetNode != nullptr && index < lastAction.linePosition) {
-                    targetNode = targetNode->next;
-                    index++;
-                }
-                if (targetNode != nullptr) {
-                    if (lastAction.charIndex >= 0 && lastAction.charIndex < targetNode->data.length()) {
-                        // Mengganti karakter kembali ke karakter lama
-                        targetNode->data[lastAction.charIndex] = lastAction.oldChar;
-                        // Menambahkan aksi ke redoStack
-                        redoStack.push(lastAction);
-                        cout << "Undo: Mengganti karakter kembali ke '" << lastAction.oldChar << "'." << endl;
-                    }
-                }
-                break;
+            return 1;
+        }
+        if (name == "insert") {
+            long long position;
+            if (!expectArguments(args, 2, 2, error) || !parseNumber(args[1], 0, position, error)) return -1;
+            editor.insertAndTrack((int)position, args[2]);
+            return 1;
+        }
+        if (name == "replace-char") {
+            if (!expectArguments(args, 1, 1, error)) return -1;
+            size_t length = 1;
+            while (length < args[1].size() && CodepointIndex::isContinuation(args[1][length])) length++;
+            if (args[1].empty() || length != args[1].size()) {
+                error = "replace-char membutuhkan tepat satu karakter";
+                return -1;
             }
-
-            case Action::REPLACE_TEXT: {
-                // Undo REPLACE_TEXT dengan mengganti kembali semua penggantian
-                for (auto it = lastAction.replacements.rbegin(); it != lastAction.replacements.rend(); ++it) {
-                    Node* targetNode = head;
-                    int index = 0;
-                    while (targetNode != nullptr && index < it->linePos) {
-                        targetNode = targetNode->next;
-                        index++;
-                    }
-                    if (targetNode != nullptr) {
-                        if (it->charIdx >= 0 && it->charIdx + it->newText.length() <= targetNode->data.length()) {
-                            // Mengganti kembali teks ke teks lama
-                            targetNode->data.replace(it->charIdx, it->newText.length(), it->oldText);
-                        }
-                    }
-                }
-                // Menambahkan aksi ke redoStack
-                redoStack.push(lastAction);
-                cout << "Undo: Mengganti kembali teks yang telah diubah." << endl;
-                break;
+            editor.replaceCurrentChar(args[1]);
+            return 1;
+        }
+        if (name == "replace" || name == "replace-parallel") {
+            if (!expectArguments(args, 2, 2, error)) return -1;
+            if (args[1].empty()) {
+                error = "teks pencarian tidak boleh kosong";
+                return -1;
             }
-
-            default:
-                cout << "Aksi tidak dikenali." << endl;
-                break;
+            if (name == "replace") editor.replaceText(args[1], args[2]);
+            else editor.replaceTextParallel(args[1], args[2]);
+            return 1;
+        }
+        if (name == "replace-words" || name == "replace-regex" || name == "search-words" || name == "search-regex") {
+            bool replacing = (name[0] == 'r');
+            if (!expectArguments(args, replacing ? 2 : 1, replacing ? 2 : 1, error)) return -1;
+            PatternSearch pattern;
+            if (!LinkedList::compilePattern(name.compare(name.size() - 5, 5, "regex") == 0, args[1], pattern, error)) {
+                error = "pola tidak valid: " + error;
+                return -1;
+            }
+            if (replacing) editor.replacePattern(pattern, args[2]);
+            else editor.searchPatternAndHighlight(pattern);
+            return 1;
+        }
+        if (name == "save") {
+            if (!expectArguments(args, 1, 1, error)) return -1;
+            if (!editor.finishSave(true, cerr)) errors++; // Penyimpanan sebelumnya ditunggu dulu
+            editor.save(args[1]);
+            return 1;
+        }
+        if (name == "goto" || name == "goto-offset") {
+            long long target;
+            if (!expectArguments(args, 1, 1, error) || !parseNumber(args[1], name == "goto" ? 1 : 0, target, error)) return -1;
+            if (!(name == "goto" ? editor.jumpToLine((int)target) : editor.jumpToOffset((size_t)target))) {
+                error = (name == "goto" ? "baris " : "offset ") + args[1] + " berada di luar dokumen";
+                return -1;
+            }
+            return 1;
+        }
+        if (name == "goto-column") {
+            long long target;
+            if (!expectArguments(args, 1, 1, error) || !parseNumber(args[1], 1, target, error)) return -1;
+            if (!editor.jumpToColumn((size_t)target)) {
+                error = "kolom " + args[1] + " berada di luar baris saat ini";
+                return -1;
+            }
+            return 1;
+        }
+        if (name == "position" || name == "count") {
+            if (!expectArguments(args, 0, 0, error)) return -1;
+            if (name == "position") editor.printPosition(cout);
+            else editor.printTextStats(cout);
+            return 1;
+        }
+        if (name == "search") {
+            if (!expectArguments(args, 1, 1, error)) return -1;
+            editor.searchAndHighlight(args[1]);
+            return 1;
+        }
+        if (name == "find-in-files") {
+            if (!expectArguments(args, 2, 2, error)) return -1;
+            if (args[2].empty()) {
+                error = "kata kunci tidak boleh kosong";
+                return -1;
+            }
+            FileFinder(args[2]).run(args[1], { &editor }); // Dokumen skrip dicari dari snapshot-nya
+            return 1;
+        }
+        if (name == "begin" || name == "commit" || name == "print" || name == "stats") {
+            if (!expectArguments(args, 0, 0, error)) return -1;
+            if (name == "begin") editor.beginTransaction();
+            else if (name == "commit") editor.commitTransaction();
+            else if (name == "print") editor.displayAll();
+            else editor.displayMemoryStats();
+            return 1;
         }
 
-        display(); // Menampilkan teks setelah undo
+        // Perintah yang bisa diulang n kali
+        auto repeat = [&](auto operation) -> long long {
+            if (!repeatCount(args, count, error)) return -1;
+            for (long long i = 0; i < count; i++) operation();
+            return count;
+        };
+        if (name == "delete-char") return repeat([this]() { editor.deleteCurrentChar(); });
+        if (name == "delete-line") return repeat([this]() { editor.deleteCurrentLine(); });
+        if (name == "next-line") return repeat([this]() { editor.moveToNextLine(); });
+        if (name == "prev-line") return repeat([this]() { editor.moveToPrevLine(); });
+        if (name == "next-char") return repeat([this]() { editor.moveToNextChar(); });
+        if (name == "prev-char") return repeat([this]() { editor.moveToPrevChar(); });
+        if (name == "undo") return repeat([this]() { editor.undo(); });
+        if (name == "redo") return repeat([this]() { editor.redo(); });
+
+        error = "perintah tidak dikenal \"" + name + "\"";
+        return -1;
     }
 
-    // Fungsi untuk melakukan redo terhadap aksi terakhir yang di-undo
-    void redo() {
-        if (redoStack.empty()) {
-            cout << "Tidak ada aksi untuk di-redo." << endl;
+    // Fungsi untuk menjalankan satu baris skrip dan mencatat waktunya
+    void runLine(const vector<string>& args, size_t lineNumber) {
+        bool printing = (args[0] == "print" || args[0] == "stats" || args[0] == "position" || args[0] == "count"
+                         || args[0] == "find-in-files");
+        if (printing) cout.clear(); // Perintah yang memang menulis ke stdout
+
+        string error;
+        auto start = chrono::steady_clock::now();
+        long long operations = execute(args, error);
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+
+        if (printing) cout.setstate(ios::badbit);
+        if (operations < 0) {
+            cerr << "Baris " << lineNumber << ": " << error << "." << endl;
+            errors++;
             return;
         }
 
-        Action lastAction = redoStack.top(); // Mengambil aksi terakhir dari redoStack
-        redoStack.pop();                      // Menghapus aksi dari redoStack
+        auto found = statsIndex.find(args[0]);
+        if (found == statsIndex.end()) {
+            found = statsIndex.emplace(args[0], commandStats.size()).first;
+            commandStats.push_back(CommandStats{ args[0], 0, 0.0 });
+        }
+        commandStats[found->second].operations += (size_t)operations;
+        commandStats[found->second].milliseconds += elapsed.count();
+        commands++;
+    }
 
-        switch (lastAction.type) {
-            case Action::INSERT_LINE:
-                // Redo INSERT_LINE dengan menyisipkan kembali baris
-                insertLine(lastAction.linePosition, lastAction.data, false);
-                // Menambahkan aksi ke undoStack untuk memungkinkan undo
-                undoStack.push(lastAction);
-                cout << "Redo: Menyisipkan kembali baris." << endl;
-                break;
+    // Fungsi untuk menulis kecepatan dalam operasi per detik ("-" jika terlalu cepat diukur)
+    static void printRate(size_t operations, double milliseconds) {
+        if (milliseconds > 0.0) cerr << (long long)(operations / (milliseconds / 1000.0));
+        else cerr << "-";
+    }
 
-            case Action::DELETE_LINE:
-                // Redo DELETE_LINE dengan menghapus kembali baris
-                deleteLine(lastAction.linePosition, false);
-                // Menambahkan aksi ke undoStack untuk memungkinkan undo
-                undoStack.push(lastAction);
-                cout << "Redo: Menghapus kembali baris." << endl;
-                break;
+    // Fungsi untuk menulis ringkasan waktu ke stderr
+    void printSummary(double totalMilliseconds) const {
+        size_t totalOperations = 0;
+        for (const CommandStats& stats : commandStats) totalOperations += stats.operations;
 
-            case Action::DELETE_CHAR: {
-                // Redo DELETE_CHAR dengan menghapus kembali karakter
-                Node* targetNode = head;
-                int index = 0;
-                while (targetNode != nullptr && index < lastAction.linePosition) {
-                    targetNode = targetNode->next;
-                    index++;
-                }
-                if (targetNode != nullptr) {
-                    if (lastAction.charIndex >= 0 && lastAction.charIndex < targetNode->data.length()) {
-                        char removedChar = targetNode->data[lastAction.charIndex];
-                        // Menghapus karakter dari baris
-                        targetNode->data.erase(lastAction.charIndex, 1);
-                        // Menambahkan aksi ke undoStack
-                        undoStack.push(lastAction);
-                        cout << "Redo: Menghapus kembali karakter '" << removedChar << "'." << endl;
-                    }
-                }
-                break;
-            }
+        cerr << "\n=== Ringkasan Batch ===\n";
+        cerr << "Perintah : " << commands << " berhasil, " << errors << " gagal\n";
+        cerr << "Operasi  : " << totalOperations << "\n";
+        cerr << "Waktu    : " << fixed << setprecision(2) << totalMilliseconds << " ms (";
+        printRate(totalOperations, totalMilliseconds);
+        cerr << " operasi/detik)\n";
+        for (const CommandStats& stats : commandStats) {
+            cerr << "  " << left << setw(18) << stats.name << right << setw(10) << stats.operations << " operasi"
+                 << setw(12) << stats.milliseconds << " ms" << setw(12);
+            printRate(stats.operations, stats.milliseconds);
+            cerr << " operasi/detik\n";
+        }
+        cerr.flush();
+    }
 
-            case Action::REPLACE_CHAR: {
-                // Redo REPLACE_CHAR dengan mengganti kembali karakter ke newChar
-                Node* targetNode = head;
-                int index = 0;
-                while (targetNode != nullptr && index < lastAction.linePosition) {
-                    targetNode = targetNode->next;
-                    index++;
-                }
-                if (targetNode != nullptr) {
-                    if (lastAction.charIndex >= 0 && lastAction.charIndex < targetNode->data.length()) {
-                        char originalChar = targetNode->data[lastAction.charIndex];
-                        // Mengganti karakter ke karakter baru
-                        targetNode->data[lastAction.charIndex] = lastAction.newChar;
-                        // Menambahkan aksi ke undoStack
-                        undoStack.push(lastAction);
-                        cout << "Redo: Mengganti karakter kembali ke '" << lastAction.newChar << "'." << endl;
-                    }
-                }
-                break;
-            }
+public:
+    explicit ScriptRunner(LinkedList& editor) : editor(editor), commands(0), errors(0) {}
 
-            case Action::REPLACE_TEXT: {
-                // Redo REPLACE_TEXT dengan mengganti kembali semua penggantian
-                for (const auto& rep : lastAction.replacements) {
-                    Node* targetNode = head;
-                    int index = 0;
-                    while (targetNode != nullptr && index < rep.linePos) {
-                        targetNode = targetNode->next;
-                        index++;
-                    }
-                    if (targetNode != nullptr) {
-                        if (rep.charIdx >= 0 && rep.charIdx + rep.oldText.length() <= targetNode->data.length()) {
-                            // Mengganti teks ke teks baru
-                            targetNode->data.replace(rep.charIdx, rep.oldText.length(), rep.newText);
-                        }
-                    }
-                }
-                // Menambahkan aksi ke undoStack
-                undoStack.push(lastAction);
-                cout << "Redo: Mengganti kembali teks yang telah diubah." << endl;
-                break;
-            }
+    // Fungsi untuk menjalankan seluruh skrip. Jika document tidak kosong, file itu
+    // dibuka terlebih dahulu. Mengembalikan 0 jika semua perintah berhasil, 1 jika tidak.
+    int run(istream& script, const string& document = "") {
+        editor.setRendering(false);
+        cout.setstate(ios::badbit); // Pesan editor tidak ditampilkan selama batch
+        auto start = chrono::steady_clock::now();
 
-            default:
-                cout << "Aksi tidak dikenali." << endl;
-                break;
+        vector<string> args;
+        string error;
+        if (!document.empty()) runLine({ "open", document }, 0);
+
+        string line;
+        size_t lineNumber = 0;
+        while (getline(script, line)) {
+            lineNumber++;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!tokenize(line, args, error)) {
+                cerr << "Baris " << lineNumber << ": " << error << "." << endl;
+                errors++;
+                continue;
+            }
+            if (args.empty() || args[0][0] == '#') continue;
+            runLine(args, lineNumber);
         }
 
-        display(); // Menampilkan teks setelah redo
+        if (!editor.finishSave(true, cerr)) errors++; // Penyimpanan terakhir ditunggu
+        editor.closeJournal(); // Skrip selesai normal; jurnal hanya dibutuhkan setelah crash
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        cout.clear();
+        editor.setRendering(true);
+        printSummary(elapsed.count());
+        return errors > 0 ? 1 : 0;
     }
 };
 
-int main() {
-    LinkedList editor;
+// EDITOR_NO_MAIN dipakai oleh program lain (misalnya bench_editor.cpp) yang menyertakan
+// file ini untuk memakai LinkedList tanpa menu
+#ifndef EDITOR_NO_MAIN
+int main(int argc, char* argv[]) {
+    Workspace workspace;
     int choice;
     bool running = true;
 
-    // Menambahkan beberapa baris awal ke dalam editor
-    editor.insertAndTrack(0, "Hidup itu seperti kopi, ");
-    editor.insertAndTrack(1, "terkadang pahit, ");
-    editor.insertAndTrack(2, "terkadang manis, ");
-    editor.insertAndTrack(3, "tapi selalu bisa dinikmati jika kita tahu caranya.");
-    editor.display(); // Menampilkan teks awal
+    // Profiler bisa diaktifkan sejak awal lewat EDITOR_PROFILE=1 (berguna untuk mode batch)
+    const char* profileFlag = getenv("EDITOR_PROFILE");
+    if (profileFlag != nullptr && *profileFlag != '\0' && strcmp(profileFlag, "0") != 0) {
+        workspace.active().setProfiling(true);
+    }
+
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        // Mode batch: --batch [skrip] [file]; tanpa skrip atau "-" berarti skrip dari stdin
+        LinkedList& editor = workspace.active(); // Mode batch selalu bekerja pada satu buffer
+        ScriptRunner runner(editor);
+        string scriptPath = (argc > 2) ? argv[2] : "-";
+        string document = (argc > 3) ? argv[3] : "";
+        int status;
+        if (scriptPath == "-") {
+            status = runner.run(cin, document);
+        }
+        else {
+            ifstream script(scriptPath);
+            if (!script) {
+                cerr << "Gagal membuka skrip \"" << scriptPath << "\"." << endl;
+                return 1;
+            }
+            status = runner.run(script, document);
+        }
+        if (editor.isProfiling()) editor.reportProfile(cerr); // Laporan saat keluar
+        return status;
+    }
+
+    if (argc > 1) {
+        // Membuka file yang diberikan lewat argumen baris perintah; file berikutnya
+        // dimuat di latar belakang ke buffer baru
+        workspace.active().openFile(argv[1]);
+        for (int i = 2; i < argc; i++) workspace.openInNewBuffer(argv[i]);
+    }
+    else {
+        // Menambahkan beberapa baris awal ke dalam editor
+        LinkedList& editor = workspace.active();
+        editor.insertAndTrack(0, "Hidup itu seperti kopi, ");
+        editor.insertAndTrack(1, "terkadang pahit, ");
+        editor.insertAndTrack(2, "terkadang manis, ");
+        editor.insertAndTrack(3, "tapi selalu bisa dinikmati jika kita tahu caranya.");
+        editor.display(); // Menampilkan teks awal
+    }
 
     // Loop utama untuk menampilkan menu dan menerima input pengguna
     while (running) {
+        workspace.poll(); // Memasang file yang selesai dimuat, melaporkan penyimpanan, menulis jurnal
+        LinkedList& editor = workspace.active();
         cout << "\n=== Menu Editor Teks ===\n";
         cout << "1. Insert Teks\n";
         cout << "2. Delete Karakter Saat Ini\n";
@@ -755,8 +4823,22 @@ int main() {
         cout << "11. Tampilkan Teks\n";
         cout << "12. Hapus Satu Baris\n";
         cout << "13. Replace Teks Berdasarkan Pencarian\n"; // Opsi baru
-        cout << "14. Keluar\n"; // Penyesuaian nomor opsi
-        cout << "Pilih opsi (1-14): ";
+        cout << "14. Statistik Memori\n";
+        cout << "15. Buka File\n";
+        cout << "16. Replace Teks Paralel\n";
+        cout << "17. Cari Pola (Banyak Kata / Regex)\n";
+        cout << "18. Replace Pola (Banyak Kata / Regex)\n";
+        cout << "19. Indeks Pencarian (Aktif/Nonaktif)\n";
+        cout << "20. Batas Memori Riwayat Undo\n";
+        cout << "21. Mulai / Selesaikan Transaksi\n";
+        cout << "22. Profil Operasi\n";
+        cout << "23. Simpan File\n";
+        cout << "24. Lompat ke Baris / Offset\n";
+        cout << "25. Buffer (Daftar / Pindah / Buka / Tutup)\n";
+        cout << "26. Cari di Banyak File\n";
+        cout << "27. Statistik Dokumen\n";
+        cout << "28. Keluar\n"; // Penyesuaian nomor opsi
+        cout << "Pilih opsi (1-28): ";
         cin >> choice;
         cin.ignore(); // Membersihkan newline dari buffer input
 
@@ -779,11 +4861,11 @@ int main() {
                 break;
             }
             case 3: { // Ganti Karakter Saat Ini
-                char newChar;
+                string newChar;
                 cout << "Masukkan karakter baru: ";
                 cin >> newChar;
                 cin.ignore(); // Membersihkan newline dari buffer
-                editor.replaceCurrentChar(newChar); // Mengganti karakter dengan yang baru
+                editor.replaceCurrentChar(newChar); // Mengganti karakter dengan karakter UTF-8 pertama masukan
                 break;
             }
             case 4: { // Navigasi ke Baris Berikutnya
@@ -822,7 +4904,7 @@ int main() {
                 break;
             }
             case 11: { // Tampilkan Teks
-                editor.display(); // Menampilkan seluruh teks dengan highlight
+                editor.displayAll(); // Menampilkan seluruh teks dengan highlight
                 break;
             }
             case 12: { // Hapus Satu Baris
@@ -833,17 +4915,79 @@ int main() {
                 editor.replaceTextInteractive(); // Mengganti teks berdasarkan pencarian
                 break;
             }
-            case 14: { // Keluar
+            case 14: { // Statistik Memori
+                editor.displayMemoryStats(); // Menampilkan pemakaian memori arena
+                break;
+            }
+            case 15: { // Buka File
+                string path;
+                cout << "Masukkan path file yang akan dibuka: ";
+                getline(cin, path);
+                editor.openFile(path); // Memetakan file dan membangun indeks baris
+                break;
+            }
+            case 16: { // Replace Teks Paralel
+                editor.replaceTextInteractive(true); // Pencarian dan penggantian dibagi ke thread pool
+                break;
+            }
+            case 17: { // Cari Pola
+                editor.searchPatternInteractive(); // Pola dikompilasi sekali lalu dipindai sekali jalan
+                break;
+            }
+            case 18: { // Replace Pola
+                editor.replacePatternInteractive(); // Mengganti semua teks yang cocok dengan pola
+                break;
+            }
+            case 19: { // Indeks Pencarian
+                editor.toggleSearchIndex(); // Membangun atau membuang indeks trigram
+                break;
+            }
+            case 20: { // Batas Memori Riwayat Undo
+                editor.setHistoryBudgetInteractive(); // Aksi tertua dibuang jika batas terlampaui
+                break;
+            }
+            case 21: { // Mulai / Selesaikan Transaksi
+                editor.toggleTransaction(); // Aksi di antaranya menjadi satu grup undo
+                break;
+            }
+            case 22: { // Profil Operasi
+                editor.profileInteractive(); // Mengaktifkan profiler atau menampilkan laporannya
+                break;
+            }
+            case 23: { // Simpan File
+                editor.saveInteractive(); // Snapshot diambil lalu ditulis di thread terpisah
+                break;
+            }
+            case 24: { // Lompat ke Baris / Offset
+                editor.jumpInteractive(); // Indeks baris dan byte diambil dari rope, tanpa menelusuri dokumen
+                break;
+            }
+            case 25: { // Buffer
+                workspace.interactive(); // Berpindah buffer, membuka file di buffer baru, atau menutup buffer
+                break;
+            }
+            case 26: { // Cari di Banyak File
+                workspace.findInFilesInteractive(); // File dibagi ke thread pool work-stealing, hasil tampil bertahap
+                break;
+            }
+            case 27: { // Statistik Dokumen
+                editor.printTextStats(cout); // Total diperbarui setiap edit, tanpa menelusuri dokumen lagi
+                break;
+            }
+            case 28: { // Keluar
                 running = false; // Menghentikan loop menu
                 cout << "Keluar dari program." << endl;
                 break;
             }
             default: { // Penanganan opsi yang tidak valid
-                cout << "Opsi tidak valid. Silakan pilih antara 1-14." << endl;
+                cout << "Opsi tidak valid. Silakan pilih antara 1-28." << endl;
                 break;
             }
         }
     }
 
+    workspace.closeAll(); // Menunggu penyimpanan yang masih berjalan dan menghapus jurnal
+    if (workspace.active().isProfiling()) workspace.active().reportProfile(cerr); // Laporan saat keluar
     return 0;
 }
+#endif